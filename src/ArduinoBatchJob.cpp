@@ -0,0 +1,79 @@
+#include <StringHelpers.hpp>
+#include <Trace.hpp>
+#include <future>
+
+#include <ArduinoBatchJob.hpp>
+
+std::function<void(const ArduinoBuildJob &)> ArduinoBatchJob::finishedCallback;
+
+/// Constructor
+ArduinoBatchJob::ArduinoBatchJob(std::vector<ArduinoBuildJob> jobs)
+    : jobs(std::move(jobs)) {}
+
+/// Stage the sketch once, and build it for all boards concurrently
+void ArduinoBatchJob::run() {
+    size_t boards = 0;
+    for (const ArduinoBuildJob &job : jobs)
+        boards += job.fqbn != "skip";
+    if (boards < 2) {
+        for (ArduinoBuildJob &job : jobs) {
+            job.run();
+            if (finishedCallback)
+                finishedCallback(job);
+        }
+        return;
+    }
+
+    // Stage in RAM if all boards fit in the budget, on disk otherwise
+    std::vector<uintmax_t> reserved;
+    for (size_t i = 0; i < boards; ++i) {
+        uintmax_t r = ArduinoBuildJob::reserveRam();
+        if (r == 0)
+            break;
+        reserved.push_back(r);
+    }
+    if (reserved.size() < boards) {
+        for (uintmax_t r : reserved)
+            ArduinoBuildJob::releaseRam(r, 0);
+        reserved.clear();
+    }
+    bool ram = !reserved.empty();
+    const fs::path &scratch =
+        ram ? ArduinoBuildJob::ramdir : ArduinoBuildJob::cachedir;
+
+    const fs::path &sketch = jobs.front().getSketch();
+    fs::path jobfolder = scratch / md5(sketch.string());
+    StagedSketch staged = ArduinoBuildJob::stage(sketch, jobfolder, ram);
+    uintmax_t stagedSize = ArduinoBuildJob::getDirectorySize(jobfolder);
+
+    // Each board has its own build folder, and its own timeline below the
+    // one of this job slot, because the spans of the boards overlap. The
+    // builders still wait for free builder slots, so no more than --parallel
+    // of them run at once.
+    unsigned int tid = Trace::getThread();
+    std::vector<std::future<void>> builds;
+    builds.reserve(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        auto build = [this, i, &staged, tid] {
+            std::string name = "Job slot " + std::to_string(tid - 1) +
+                               ", board " + std::to_string(i);
+            Trace::setThread(tid * 1000 + i, name);
+            jobs[i].run(&staged);
+            if (finishedCallback)
+                finishedCallback(jobs[i]);
+        };
+        builds.push_back(std::async(std::launch::async, build));
+    }
+    for (auto &build : builds)
+        build.get();
+
+    auto reservation = reserved.begin();
+    for (const ArduinoBuildJob &job : jobs)
+        if (job.fqbn != "skip" && reservation != reserved.end())
+            ArduinoBuildJob::releaseRam(*reservation++,
+                                        stagedSize + job.scratchUsed);
+    if (ram) {
+        std::error_code ec;
+        fs::remove_all(jobfolder, ec);
+    }
+}
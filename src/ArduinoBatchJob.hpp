@@ -0,0 +1,26 @@
+#pragma once
+
+#include <ArduinoBuildJob.hpp>
+#include <functional>
+#include <vector>
+
+/// Builds one sketch for multiple boards. The sketch is staged and its
+/// libraries are resolved only once, and the boards are then built
+/// concurrently from the same staged sketch. There is still one result per
+/// board, in the individual build jobs.
+class ArduinoBatchJob {
+  public:
+    ArduinoBatchJob(std::vector<ArduinoBuildJob> jobs);
+
+    void run();
+
+    const std::vector<ArduinoBuildJob> &getJobs() const { return jobs; }
+    std::vector<ArduinoBuildJob> &getJobs() { return jobs; }
+
+    /// Called by the worker thread as soon as the job of a board finishes,
+    /// before the other boards of the batch are done
+    static std::function<void(const ArduinoBuildJob &)> finishedCallback;
+
+  private:
+    std::vector<ArduinoBuildJob> jobs;
+};
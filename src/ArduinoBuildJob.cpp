@@ -1,23 +1,44 @@
+#include <CpuAffinity.hpp>
+#include <PrecompiledHeader.hpp>
 #include <Printing.hpp>
 #include <StringHelpers.hpp>
+#include <Trace.hpp>
+#include <algorithm>
+#include <condition_variable>
 #include <fmt/format.h>
 #include <fstream>
+#include <future>
+#include <map>
+#include <regex>
+#include <set>
 #include <unordered_map>
 
 #include <ArduinoBuildJob.hpp>
 
 /// Constructor
-ArduinoBuildJob::ArduinoBuildJob(fs::path sketch, std::string board)
-    : sketch(sketch), board(board) {
-    if (boardOptions.count(tolower_copy(board)) == 0) {
+ArduinoBuildJob::ArduinoBuildJob(fs::path sketch, std::string board,
+                                 size_t root)
+    : sketch(sketch), board(board), root(root) {
+    const BoardOptions &options = rootBoardOptions.at(root);
+    auto option = options.find(tolower_copy(board));
+    if (option == options.end()) {
         throw std::runtime_error("Error: unknown board `" + board +
                                  "` in file \"" + sketch.string() + "\"");
     }
+    fqbn = option->second;
+}
+
+ArduinoBuildJob::ArduinoBuildJob(const JournalEntry &entry, size_t root)
+    : sketch(entry.sketch), board(entry.board), root(root),
+      result{entry.status, entry.output}, skipped(entry.skipped) {
+    if (result.status == 0)
+        size = parseFirmwareSize(result.output);
 }
 
-/// Build the sketch for the given board
-void ArduinoBuildJob::run() {
-    if (boardOptions[tolower_copy(board)] == "skip") {
+/// Build the sketch for the given board, optionally using a sketch that was
+/// already staged for multiple boards (see ArduinoBatchJob)
+void ArduinoBuildJob::run(const StagedSketch *staged) {
+    if (fqbn == "skip") {
         LockedYellow(std::cout, cout_mutex)
             << "Skipped " << sketch.filename() << " for board " << board << "."
             << std::endl;
@@ -25,53 +46,343 @@ void ArduinoBuildJob::run() {
         return;
     }
 
-    using namespace fmt::literals;
-
     LockedBlueB(std::cout, cout_mutex)
         << "Building Example " << sketch.filename() << " for board " << board
         << std::endl;
 
-    fs::path boardCachedir = cachedir / board;
-    fs::create_directories(boardCachedir);
+    auto starttime = std::chrono::steady_clock::now();
 
-    std::string hash = md5(sketch.string() + board);
-    fs::path tmpsketchfolder = cachedir / hash;
+    // Reuse the result of an identical build from the remote cache
+    std::optional<ExecResult> cached;
+    if (remoteCache.isEnabled()) {
+        TraceSpan span("remote cache lookup " + sketch.filename().string() +
+                           " (" + board + ")",
+                       "job");
+        actionKey = getActionKey();
+        cached = remoteCache.lookup(actionKey, cachedir / "remote");
+    }
+
+    // Stage and build in RAM if it fits in the budget, on disk otherwise
+    uintmax_t reserved = cached || staged ? 0 : reserveRam();
+    if (cached) {
+        result = std::move(*cached);
+        LockedBlue(std::cout, cout_mutex)
+            << "Found " << sketch.filename() << " for board " << board
+            << " in the remote cache" << std::endl;
+    } else if (staged) {
+        // The boards share the staged sketch, so each needs its own build
+        // folder
+        fs::path buildfolder = staged->jobfolder / ("build-" + md5(board));
+        fs::create_directories(buildfolder);
+        result = build(*staged, buildfolder);
+        if (staged->scratch) {
+            scratchUsed = getDirectorySize(buildfolder);
+            std::error_code ec;
+            fs::remove_all(buildfolder, ec);
+            if (result.status != 0 &&
+                result.output.find("No space left on device") !=
+                    std::string::npos)
+                result = compile(false);
+        }
+    } else if (reserved > 0) {
+        result = compile(true);
+        releaseRam(reserved, scratchUsed);
+        if (result.status != 0 &&
+            result.output.find("No space left on device") != std::string::npos)
+            result = compile(false);
+    } else {
+        result = compile(false);
+    }
+
+    std::chrono::duration<double> diff =
+        std::chrono::steady_clock::now() - starttime;
+    duration = diff.count();
+
+    if (result.status == 0) {
+        size = parseFirmwareSize(result.output);
+        LockedGreenB(std::cout, cout_mutex)
+            << "Built " << sketch.filename() << " successfully for board "
+            << board << "! ✔" << std::endl;
+    } else {
+        LockedRedB(std::cout, cout_mutex)
+            << "Builing " << sketch.filename() << " for " << board << " failed!"
+            << std::endl;
+    }
+}
+
+/// Get the total size of all files in the given directory
+uintmax_t ArduinoBuildJob::getDirectorySize(const fs::path &dir) {
+    uintmax_t size = 0;
+    std::error_code ec;
+    for (auto &p : fs::recursive_directory_iterator(dir, ec))
+        if (p.is_regular_file(ec))
+            size += p.file_size(ec);
+    return size;
+}
+
+/// Copy the sketch to a staging folder in the given job folder, and select
+/// the libraries it needs. A scratch folder is emptied first, other staging
+/// folders are updated in place, so the builder can reuse its output of the
+/// previous run.
+StagedSketch ArduinoBuildJob::stage(const fs::path &sketch,
+                                    const fs::path &jobfolder, bool scratch) {
+    StagedSketch staged;
+    staged.jobfolder = jobfolder;
+    staged.scratch = scratch;
+    // The main file has to match the name of its folder
+    fs::path tmpsketchfolder = jobfolder / jobfolder.filename();
     fs::path tmpsketch = tmpsketchfolder / sketch.filename();
-    fs::path tmpsketchhash = tmpsketchfolder / (hash + ".ino");
-    fs::create_directories(tmpsketchfolder);
-    fs::copy(sketch.parent_path(), tmpsketchfolder,
-             fs::copy_options::update_existing | fs::copy_options::recursive);
-    fs::rename(tmpsketch, tmpsketchhash);
+    staged.file = tmpsketchfolder / (jobfolder.filename().string() + ".ino");
+    {
+        TraceSpan span("staging " + sketch.filename().string(), "job");
+        if (scratch)
+            fs::remove_all(jobfolder);
+        fs::create_directories(tmpsketchfolder);
+        fs::copy(sketch.parent_path(), tmpsketchfolder,
+                 fs::copy_options::update_existing |
+                     fs::copy_options::recursive);
+        fs::rename(tmpsketch, staged.file);
+    }
+
+    // Only make the libraries that the sketch needs visible to the builder
+    if (useLibraryIndex) {
+        TraceSpan span("resolve libraries " + sketch.filename().string(),
+                       "job");
+        fs::path view = jobfolder / "libraries";
+        fs::remove_all(view);
+        LibraryIndex::createView(view, libraryIndex.resolve(tmpsketchfolder));
+        staged.libraries = "-libraries \"" + view.string() + "\" ";
+    }
+    return staged;
+}
+
+/// Stage the sketch and build it. In RAM, only the core cache is written to
+/// the cache directory, the staged sketch and build output are removed
+/// afterwards. On disk, the staged sketch is kept in the cache directory, and
+/// the builder uses its default build path, so both can be reused by the
+/// next run.
+ExecResult ArduinoBuildJob::compile(bool ram) {
+    std::string hash = md5(sketch.string() + board);
+    if (!ram) {
+        StagedSketch staged = stage(sketch, cachedir / hash, false);
+        // The artifacts can only be uploaded from a known build path
+        fs::path buildfolder;
+        if (!actionKey.empty())
+            buildfolder = staged.jobfolder / "build";
+        return build(staged, buildfolder);
+    }
+    fs::path jobfolder = ramdir / hash;
+    StagedSketch staged = stage(sketch, jobfolder, true);
+    ExecResult result = build(staged, jobfolder / "build");
+    scratchUsed = getDirectorySize(jobfolder);
+    std::error_code ec;
+    fs::remove_all(jobfolder, ec);
+    return result;
+}
+
+/// Run the builder for this board on a staged sketch. If no build folder is
+/// given, the builder's default build path is used.
+ExecResult ArduinoBuildJob::build(const StagedSketch &staged,
+                                  const fs::path &buildfolder) {
+    using namespace fmt::literals;
+
+    std::string buildpath;
+    if (!buildfolder.empty()) {
+        fs::create_directories(buildfolder);
+        buildpath = "-build-path \"" + buildfolder.string() + "\" ";
+    }
+
+    fs::path boardCachedir = getCoreCacheFolder(fqbn);
+    fs::create_directories(boardCachedir);
+    std::string tracename = sketch.filename().string() + " (" + board + ")";
+
+    std::string pch =
+        precompiledHeaders ? getPrecompiledHeaderArgs(fqbn) : std::string();
 
     std::string cmd = //
         fmt::format("cd \"{folder}\" && "
                     "unbuffer "
                     "{command} "
+                    "{pch}"
+                    "{libraries}"
                     "-fqbn {fqbn} "
                     "-build-cache \"{cachedir}\" "
+                    "{buildpath}"
                     "-compile \"{file}\" 2>&1",
 
-                    "folder"_a = arduinoFolder.string(),          //
-                    "command"_a = command,                        //
-                    "fqbn"_a = boardOptions[tolower_copy(board)], //
-                    "cachedir"_a = boardCachedir.string(),        //
-                    "file"_a = tmpsketchhash.string());
+                    "folder"_a = arduinoFolder.string(),   //
+                    "command"_a = command,                 //
+                    "pch"_a = pch,                         //
+                    "libraries"_a = staged.libraries,      //
+                    "fqbn"_a = fqbn,                       //
+                    "cachedir"_a = boardCachedir.string(), //
+                    "buildpath"_a = buildpath,             //
+                    "file"_a = staged.file.string());
 
     if (verbose) {
         LockedOStream(std::cout, cout_mutex) << cmd << std::endl;
     }
 
-    result = exec(cmd);
+    ExecResult result;
+    {
+        // Batched boards share a job slot, but every builder needs a slot of
+        // its own, pinned to that slot's CPUs
+        size_t slot = acquireBuilder();
+        std::optional<cpu_set_t> cpus;
+        if (slot < builderCpuSets.size()) {
+            cpus = getCurrentThreadCpus();
+            pinCurrentThread(builderCpuSets[slot]);
+        }
+        TraceSpan span("compile " + tracename, "job");
+        result = exec(cmd);
+        if (cpus)
+            pinCurrentThread(*cpus);
+        releaseBuilder(slot);
+    }
+    if (result.status == 0 && !actionKey.empty() && !buildfolder.empty()) {
+        TraceSpan span("remote cache upload " + tracename, "job");
+        remoteCache.upload(actionKey, result, buildfolder,
+                           buildfolder / "remote");
+    }
+    return result;
+}
 
-    if (result.status == 0) {
-        LockedGreenB(std::cout, cout_mutex)
-            << "Built " << sketch.filename() << " successfully for board "
-            << board << "! ✔" << std::endl;
+static std::mutex builderMutex;
+static std::condition_variable builderReleased;
+/// Builder slots that are not in use, at most --parallel builders run at once
+static std::vector<size_t> freeBuilders;
+
+/// Wait for a free builder slot and take it
+size_t ArduinoBuildJob::acquireBuilder() {
+    std::unique_lock<std::mutex> lock(builderMutex);
+    builderReleased.wait(lock, [] { return !freeBuilders.empty(); });
+    size_t slot = freeBuilders.back();
+    freeBuilders.pop_back();
+    return slot;
+}
+
+void ArduinoBuildJob::releaseBuilder(size_t slot) {
+    {
+        std::lock_guard<std::mutex> lock(builderMutex);
+        freeBuilders.push_back(slot);
+    }
+    builderReleased.notify_one();
+}
+
+static std::mutex ramMutex;
+/// Bytes of the RAM budget that are currently reserved by running jobs
+static uintmax_t ramReserved = 0;
+/// Expected size of a single job, updated with the largest job seen so far
+static uintmax_t ramEstimate = 64 * 1024 * 1024;
+
+/// Reserve room for one job in the RAM-backed scratch directory.
+/// Returns the number of bytes reserved, or zero if the job should use the
+/// disk instead.
+uintmax_t ArduinoBuildJob::reserveRam() {
+    if (ramdir.empty())
+        return 0;
+    std::lock_guard<std::mutex> lock(ramMutex);
+    std::error_code ec;
+    auto space = fs::space(ramdir, ec);
+    if (ec || ramReserved + ramEstimate > ramBudget ||
+        space.available < ramEstimate)
+        return 0;
+    ramReserved += ramEstimate;
+    return ramEstimate;
+}
+
+/// Release the reservation of a job, and learn from its actual size.
+void ArduinoBuildJob::releaseRam(uintmax_t reserved, uintmax_t used) {
+    std::lock_guard<std::mutex> lock(ramMutex);
+    ramReserved -= reserved;
+    ramEstimate = std::max(ramEstimate, used);
+}
+
+static std::mutex folderHashMutex;
+static std::map<fs::path, std::shared_future<std::string>> folderHashes;
+
+/// Hash the contents of a folder, once per run. Concurrent callers wait for
+/// the first one instead of hashing the same folder again.
+static std::string getFolderHash(const fs::path &folder) {
+    std::promise<std::string> promise;
+    std::shared_future<std::string> hash;
+    bool owner = false;
+    {
+        std::lock_guard<std::mutex> lock(folderHashMutex);
+        auto it = folderHashes.find(folder);
+        if (it == folderHashes.end()) {
+            hash = folderHashes[folder] = promise.get_future().share();
+            owner = true;
+        } else {
+            hash = it->second;
+        }
+    }
+    if (owner) {
+        try {
+            promise.set_value(hashFolder(folder));
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }
+    return hash.get();
+}
+
+/// Get the platform folder of the given FQBN, and the platform folders that
+/// its board borrows the core or the variant from (`build.core=vendor:core`
+/// in boards.txt)
+static std::set<fs::path> getPlatformFolders(const std::string &fqbn) {
+    std::set<fs::path> folders;
+    fs::path platform = ArduinoBuildJob::getCoreFolder(fqbn);
+    if (platform.empty())
+        return folders;
+    folders.insert(platform);
+
+    std::smatch match;
+    std::regex re("^[^:]+:([^:]+):([^:]+).*$");
+    if (!std::regex_match(fqbn, match, re) || match.size() != 3)
+        return folders;
+    std::string arch = match[1], board = match[2];
+    std::ifstream boardstxt = platform / "boards.txt";
+    std::string line;
+    while (std::getline(boardstxt, line)) {
+        auto eq = line.find('=');
+        if (eq == std::string::npos)
+            continue;
+        std::string key = trim_copy(line.substr(0, eq));
+        std::string value = trim_copy(line.substr(eq + 1));
+        auto colon = value.find(':');
+        if ((key == board + ".build.core" || key == board + ".build.variant") &&
+            colon != std::string::npos) {
+            fs::path folder = ArduinoBuildJob::getCoreFolder(
+                value.substr(0, colon) + ":" + arch + ":" + board);
+            if (!folder.empty())
+                folders.insert(folder);
+        }
+    }
+    return folders;
+}
+
+/// Get the hash of all inputs of the build: the sketch folder, the board, the
+/// core sources, the builder command line and the libraries.
+std::string ArduinoBuildJob::getActionKey() const {
+    std::string libraries;
+    if (useLibraryIndex) {
+        for (auto &library : libraryIndex.resolve(sketch.parent_path()))
+            libraries += library.filename().string() + ' ' +
+                         getFolderHash(library) + '\n';
     } else {
-        LockedRedB(std::cout, cout_mutex)
-            << "Builing " << sketch.filename() << " for " << board << " failed!"
-            << std::endl;
+        for (auto &folder : libraryFolders)
+            libraries += getFolderHash(folder) + '\n';
     }
+    // The platform folders contain the core sources and the variants, which
+    // can change without a new version
+    std::string core;
+    for (auto &folder : getPlatformFolders(fqbn))
+        core += getFolderHash(folder) + '\n';
+    return md5(getFolderHash(sketch.parent_path()) + '\n' +
+               sketch.filename().string() + '\n' + fqbn + '\n' + core +
+               command + '\n' + (precompiledHeaders ? "pch\n" : "") +
+               libraries);
 }
 
 /// Get the Arduino IDE installation folder
@@ -116,12 +427,14 @@ static bool isComment(const std::string &line) {
 }
 
 /// Load the board name to fully qualified board name mappings from a file
-void ArduinoBuildJob::loadBoardOptions(const Options &options) {
-    std::ifstream file = options.boardOptions;
+BoardOptions ArduinoBuildJob::loadBoardOptions(const fs::path &path,
+                                               const std::string &defaults) {
+    BoardOptions boardOptions;
+    std::ifstream file = path;
     if (!file.good())
         Yellow(std::cerr) << "Warning: board options file doesn't exist ("
-                          << options.boardOptions << ")" << std::endl;
-    std::string line = options.defaultBoardOptions;
+                          << path << ")" << std::endl;
+    std::string line = defaults;
     do {
         if (isComment(line))
             continue;
@@ -131,6 +444,7 @@ void ArduinoBuildJob::loadBoardOptions(const Options &options) {
             boardOptions[tolower_copy(match[1])] = match[2];
         }
     } while (std::getline(file, line));
+    return boardOptions;
 }
 
 /// Get the supported board names from a given sketch
@@ -154,21 +468,124 @@ std::vector<std::string> ArduinoBuildJob::getBoards(const fs::path &sketch) {
     return {};
 }
 
+/// Compare two dotted version strings numerically (e.g. 1.8.10 > 1.8.9)
+static bool versionLess(const std::string &a, const std::string &b) {
+    std::istringstream sa(a), sb(b);
+    std::string pa, pb;
+    while (true) {
+        bool ha = bool(std::getline(sa, pa, '.'));
+        bool hb = bool(std::getline(sb, pb, '.'));
+        if (!ha || !hb)
+            return !ha && hb;
+        if (pa != pb) {
+            try {
+                return std::stoi(pa) < std::stoi(pb);
+            } catch (std::invalid_argument &) {
+                return pa < pb;
+            }
+        }
+    }
+}
+
+/// Read the `version=` property from a platform.txt file
+static std::string getPlatformVersion(const fs::path &platformtxt) {
+    std::ifstream file = platformtxt;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::smatch match;
+        std::regex re("^\\s*version\\s*=\\s*(.*)$");
+        if (std::regex_match(line, match, re) && match.size() == 2)
+            return trim_copy(match[1]);
+    }
+    return "";
+}
+
+/// Get the platform folder of the core that provides the given fully
+/// qualified board name, or an empty path if it couldn't be found
+fs::path ArduinoBuildJob::getCoreFolder(const std::string &fqbn) {
+    std::smatch match;
+    std::regex re("^([^:]+):([^:]+):.*$");
+    if (!std::regex_match(fqbn, match, re) || match.size() != 3)
+        return "";
+    std::string vendor = match[1], arch = match[2];
+
+    // Cores installed by the boards manager (latest version wins)
+    fs::path home = getenv("HOME");
+    fs::path packages = home / ".arduino15" / "packages" / vendor /
+                        "hardware" / arch;
+    fs::path folder;
+    std::string version;
+    std::error_code ec;
+    for (auto &p : fs::directory_iterator(packages, ec)) {
+        std::string v = getPlatformVersion(p.path() / "platform.txt");
+        if (!v.empty() && (version.empty() || versionLess(version, v))) {
+            folder = p.path();
+            version = v;
+        }
+    }
+    if (!folder.empty())
+        return folder;
+
+    // Cores bundled with the IDE or installed in the sketchbook
+    for (const fs::path &hardware : {home / "Arduino" / "hardware",
+                                     arduinoFolder / "hardware"}) {
+        fs::path platform = hardware / vendor / arch;
+        if (fs::exists(platform / "platform.txt"))
+            return platform;
+    }
+    return {};
+}
+
+/// Get the version of the core that provides the given fully qualified board
+/// name, or an empty string if it couldn't be found
+std::string ArduinoBuildJob::getCoreVersion(const std::string &fqbn) {
+    fs::path folder = getCoreFolder(fqbn);
+    if (folder.empty())
+        return "";
+    return getPlatformVersion(folder / "platform.txt");
+}
+
+/// Get the folder with the core cache of the given FQBN. Boards with the same
+/// FQBN share it, even if they have different names in different roots.
+fs::path ArduinoBuildJob::getCoreCacheFolder(const std::string &fqbn) {
+    std::string name = fqbn;
+    std::replace(name.begin(), name.end(), ':', '_');
+    return cachedir / "cores" / name;
+}
+
+/// Get the key that identifies the contents of the core cache of an FQBN:
+/// the cache can only be reused for the same FQBN, core version and builder
+/// options that affect the core. The number of jobs, the libraries and the
+/// installation paths don't change the compiled core.
+std::string ArduinoBuildJob::getCacheKey(const std::string &fqbn) {
+    return md5(fqbn + '\n' + getCoreVersion(fqbn) + '\n' + cacheKeyArgs);
+}
+
 void ArduinoBuildJob::configure(const Options &options) {
-    loadBoardOptions(options);
+    for (const RootOptions &root : options.roots) {
+        rootBoardOptions.push_back(
+            loadBoardOptions(root.boardOptions, options.defaultBoardOptions));
+        for (auto &option : rootBoardOptions.back())
+            if (option.second != "skip")
+                fqbns.insert(option.second);
+    }
     verbose = options.verbose;
     fs::path home = getenv("HOME");
     arduinoFolder = getArduinoFolder();
     fs::path defaultLibraries = home / "Arduino" / "libraries";
     std::string defaultVersion = getArduinoVersion(arduinoFolder).str();
 
-    std::string defaults = "-hardware {arduino}/hardware "
+    // With the library index, the libraries are passed for each job
+    useLibraryIndex = options.libraryIndex && !options.noDefaults;
+    std::string hardware = "-hardware {arduino}/hardware "
                            "-hardware {home}/.arduino15/packages "
                            "-tools {arduino}/tools-builder "
-                           "-tools {home}/.arduino15/packages "
-                           "-built-in-libraries {arduino}/libraries "
-                           "-libraries {libraries} "
-                           "-core-api-version {version} "
+                           "-tools {home}/.arduino15/packages ";
+    std::string defaults = hardware;
+    if (!useLibraryIndex)
+        defaults += "-built-in-libraries {arduino}/libraries "
+                    "-libraries {libraries} ";
+    defaults += "-core-api-version {version} "
                            "-warnings all "
                            "-jobs {jobs} ";
     using namespace fmt::literals;
@@ -182,13 +599,49 @@ void ArduinoBuildJob::configure(const Options &options) {
     command = "arduino-builder ";
     if (!options.noDefaults)
         command += defaults;
+    // The placeholders are not expanded, so the key doesn't depend on where
+    // the IDE and the cores are installed
+    cacheKeyArgs = options.noDefaults
+                       ? options.options
+                       : hardware + "-core-api-version " + defaultVersion +
+                             " -warnings all";
+
+    // User libraries take precedence over the built-in ones
+    libraryFolders = {defaultLibraries, arduinoFolder / "libraries"};
+    if (useLibraryIndex) {
+        libraryIndex.build(libraryFolders);
+        if (verbose)
+            std::cout << "Indexed " << libraryIndex.size() << " libraries"
+                      << std::endl;
+    }
 
+    for (size_t slot = std::max(options.parallel, 1u); slot-- > 0;)
+        freeBuilders.push_back(slot);
+
+    precompiledHeaders = options.precompiledHeaders;
+    remoteCache = RemoteCache(options.remoteCache);
     cachedir = options.cacheDirectory;
     fs::create_directories(cachedir);
+
+    if (!options.ramDirectory.empty()) {
+        ramdir = options.ramDirectory / "arduino-example-builder";
+        ramBudget = options.ramBudget;
+        fs::create_directories(ramdir);
+    }
 }
 
 std::string ArduinoBuildJob::command;
+std::string ArduinoBuildJob::cacheKeyArgs;
+fs::path ArduinoBuildJob::ramdir;
+uintmax_t ArduinoBuildJob::ramBudget = 0;
+bool ArduinoBuildJob::precompiledHeaders = false;
+bool ArduinoBuildJob::useLibraryIndex = false;
+LibraryIndex ArduinoBuildJob::libraryIndex;
+std::vector<fs::path> ArduinoBuildJob::libraryFolders;
+RemoteCache ArduinoBuildJob::remoteCache;
 fs::path ArduinoBuildJob::cachedir;
 fs::path ArduinoBuildJob::arduinoFolder;
-std::unordered_map<std::string, std::string> ArduinoBuildJob::boardOptions;
+std::set<std::string> ArduinoBuildJob::fqbns;
+std::vector<BoardOptions> ArduinoBuildJob::rootBoardOptions;
+std::vector<cpu_set_t> ArduinoBuildJob::builderCpuSets;
 bool ArduinoBuildJob::verbose = false;
\ No newline at end of file
@@ -1,49 +1,133 @@
 #pragma once
 
 #include <Exec.hpp>
+#include <FirmwareSize.hpp>
+#include <Journal.hpp>
+#include <LibraryIndex.hpp>
+#include <RemoteCache.hpp>
 #include <filesystem>
+#include <sched.h>
+#include <set>
 #include <unordered_map>
+#include <vector>
 
 namespace fs = std::filesystem;
 
+/// Board name to fully qualified board name mappings
+using BoardOptions = std::unordered_map<std::string, std::string>;
+
+/// A directory with examples, and the boards to build them for
+struct RootOptions {
+    fs::path directory;
+    fs::path boardOptions;
+    std::string defaultBoard;
+};
+
 struct Options {
     bool noDefaults = false;
     std::string options = "";
-    fs::path directory;
-    fs::path boardOptions;
+    std::vector<RootOptions> roots;
     fs::path cacheDirectory;
-    std::string defaultBoard;
     std::string defaultBoardOptions;
+    fs::path exportCache;
+    fs::path importCache;
+    fs::path ramDirectory;
+    uintmax_t ramBudget = 0;
+    bool precompiledHeaders = false;
+    bool libraryIndex = false;
+    fs::path sizeHistory;
+    std::string maxSizeRegression;
+    bool resume = false;
+    bool rerunFailed = false;
+    bool fastFeedback = false;
+    double timeBudget = 0;
+    std::string remoteCache;
+    bool batchBoards = false;
     unsigned int jobs = 0;
     unsigned int parallel = 0;
     bool verbose = false;
 };
 
+/// A sketch that was copied to a staging folder, ready to be built
+struct StagedSketch {
+    fs::path jobfolder;
+    fs::path file;
+    std::string libraries; ///< Arguments that select the libraries to use
+    bool scratch = false;  ///< Removed after the build
+};
+
 class ArduinoBuildJob {
   public:
-    ArduinoBuildJob(fs::path sketch, std::string board);
+    ArduinoBuildJob(fs::path sketch, std::string board, size_t root = 0);
+    /// Restore a job that already completed in a previous run
+    ArduinoBuildJob(const JournalEntry &entry, size_t root = 0);
 
-    void run();
+    void run(const StagedSketch *staged = nullptr);
 
     bool getSkipped() const { return skipped; }
     const ExecResult &getResult() const { return result; }
+    const FirmwareSize &getSize() const { return size; }
     const fs::path &getSketch() const { return sketch; }
     const std::string &getBoard() const { return board; }
+    size_t getRoot() const { return root; }
+    /// The time it took to build the sketch, in seconds
+    double getDuration() const { return duration; }
+    JournalEntry getJournalEntry() const {
+        return {sketch.string(), board, result.status, skipped, result.output};
+    }
 
     static std::vector<std::string> getBoards(const fs::path &sketch);
 
     static void configure(const Options &options);
-    static void loadBoardOptions(const Options &options);
+    static BoardOptions loadBoardOptions(const fs::path &file,
+                                         const std::string &defaults);
+
+    static fs::path getCoreFolder(const std::string &fqbn);
+    static std::string getCoreVersion(const std::string &fqbn);
+    static fs::path getCoreCacheFolder(const std::string &fqbn);
+    static std::string getCacheKey(const std::string &fqbn);
 
     static std::string command;
+    /// The builder options that affect the compiled core
+    static std::string cacheKeyArgs;
     static fs::path arduinoFolder;
     static fs::path cachedir;
-    static std::unordered_map<std::string, std::string> boardOptions;
+    static fs::path ramdir;
+    static uintmax_t ramBudget;
+    static bool precompiledHeaders;
+    static bool useLibraryIndex;
+    static LibraryIndex libraryIndex;
+    static std::vector<fs::path> libraryFolders;
+    static RemoteCache remoteCache;
+    /// All FQBNs that the examples of all roots can be built for
+    static std::set<std::string> fqbns;
+    static std::vector<BoardOptions> rootBoardOptions;
+    /// The CPU set of each builder slot, if the builders are pinned
+    static std::vector<cpu_set_t> builderCpuSets;
     static bool verbose;
 
   private:
+    friend class ArduinoBatchJob;
+
+    static StagedSketch stage(const fs::path &sketch,
+                              const fs::path &jobfolder, bool scratch);
+    static uintmax_t getDirectorySize(const fs::path &dir);
+    ExecResult compile(bool ram);
+    ExecResult build(const StagedSketch &staged, const fs::path &buildfolder);
+    std::string getActionKey() const;
+    static uintmax_t reserveRam();
+    static void releaseRam(uintmax_t reserved, uintmax_t used);
+    static size_t acquireBuilder();
+    static void releaseBuilder(size_t slot);
+
     fs::path sketch;
     std::string board;
+    size_t root = 0;
+    std::string fqbn;
     ExecResult result;
+    FirmwareSize size;
     bool skipped = false;
+    double duration = 0;
+    std::string actionKey;
+    uintmax_t scratchUsed = 0;
 };
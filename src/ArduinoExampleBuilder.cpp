@@ -1,14 +1,25 @@
 #include <algorithm>
 #include <filesystem>
+#include <fstream>
 #include <iomanip>
+#include <map>
+#include <mutex>
 #include <regex>
 #include <set>
 #include <stdexcept>
 #include <string>
 
+#include <ArduinoBatchJob.hpp>
 #include <ArduinoBuildJob.hpp>
+#include <CoreCache.hpp>
+#include <CpuAffinity.hpp>
+#include <FirmwareSize.hpp>
 #include <JobServer.hpp>
+#include <JobStats.hpp>
+#include <Journal.hpp>
 #include <Printing.hpp>
+#include <StringHelpers.hpp>
+#include <Trace.hpp>
 
 namespace fs = std::filesystem;
 
@@ -117,6 +128,101 @@ void printJobs(const std::vector<ArduinoBuildJob> &jobs) {
     }
 }
 
+struct SizeChange {
+    SizeHistory::Key key;
+    FirmwareSize before, after;
+    size_t root = 0;
+    bool regression = false;
+
+    long long flashDelta() const {
+        return before.flash < 0 || after.flash < 0 ? 0
+                                                   : after.flash - before.flash;
+    }
+    long long ramDelta() const {
+        return before.ram < 0 || after.ram < 0 ? 0 : after.ram - before.ram;
+    }
+};
+
+void printSizeIncreases(std::vector<SizeChange> changes, size_t count = 5) {
+    changes.erase(std::remove_if(changes.begin(), changes.end(),
+                                 [](const SizeChange &c) {
+                                     return c.flashDelta() <= 0 &&
+                                            c.ramDelta() <= 0;
+                                 }),
+                  changes.end());
+    if (changes.empty())
+        return;
+    std::sort(changes.begin(), changes.end(),
+              [](const SizeChange &a, const SizeChange &b) {
+                  return std::make_pair(a.flashDelta(), a.ramDelta()) >
+                         std::make_pair(b.flashDelta(), b.ramDelta());
+              });
+    YellowB(std::cout) << "\n"
+                       << "Largest firmware size increases: \n";
+    for (size_t i = 0; i < std::min(count, changes.size()); ++i) {
+        auto &c = changes[i];
+        std::cout << "\n"
+                  << "Sketch: " << c.key.first << "\n"
+                  << "Board: " << c.key.second << "\n"
+                  << "Flash: " << c.after.flash << " bytes (" << std::showpos
+                  << c.flashDelta() << std::noshowpos << ")\n"
+                  << "RAM: " << c.after.ram << " bytes (" << std::showpos
+                  << c.ramDelta() << std::noshowpos << ")" << std::endl;
+    }
+}
+
+/// Check if a size increase exceeds the maximum regression, either an
+/// absolute number of bytes, or a percentage of the previous size ("2.5%").
+/// Throws std::invalid_argument or std::out_of_range if the maximum is not
+/// a valid number.
+bool isSizeRegression(long long before, long long delta,
+                      const std::string &max) {
+    if (max.empty())
+        return false;
+    size_t pos = 0;
+    if (max.back() == '%') {
+        double percentage = std::stod(max, &pos);
+        if (pos != max.size() - 1)
+            throw std::invalid_argument("max-size-regression");
+        return delta > 0 && delta > before * percentage / 100;
+    }
+    long long bytes = std::stoll(max, &pos);
+    if (pos != max.size())
+        throw std::invalid_argument("max-size-regression");
+    return delta > 0 && delta > bytes;
+}
+
+/// Load a file that lists directories with examples to build, one per line:
+/// `directory [; board options file [; default board]]`
+/// Relative paths are relative to the file, missing fields are taken from
+/// the given defaults.
+std::vector<RootOptions> loadRoots(const fs::path &file,
+                                   const RootOptions &defaults) {
+    std::ifstream in = file;
+    if (!in)
+        throw std::runtime_error("Error: couldn't open roots file " +
+                                 file.string());
+    std::vector<RootOptions> roots;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (trim(line).empty() || line[0] == '#')
+            continue;
+        std::istringstream ss(line);
+        std::string directory, boardOptions, defaultBoard;
+        std::getline(ss, directory, ';');
+        std::getline(ss, boardOptions, ';');
+        std::getline(ss, defaultBoard, ';');
+        RootOptions root = defaults;
+        root.directory = file.parent_path() / trim(directory);
+        if (!trim(boardOptions).empty())
+            root.boardOptions = file.parent_path() / boardOptions;
+        if (!trim(defaultBoard).empty())
+            root.defaultBoard = defaultBoard;
+        roots.push_back(root);
+    }
+    return roots;
+}
+
 void printSkippedJobs(const std::vector<ArduinoBuildJob> &jobs) {
     for (auto &job : jobs) {
         std::cout << "\n"
@@ -136,7 +242,12 @@ int main_application(int argc, const char *argv[]) {
         "print-successful", "s", 0,
         "Print the output of successful compilations as well."};
     ArgMatcher directory = {"directory", "d", 1,
-                            "The directory with examples to compile."};
+                            "The directory with examples to compile (can be "
+                            "specified multiple times)."};
+    ArgMatcher roots = {
+        "roots", "", 1,
+        "A file with directories with examples to compile, one per line:"
+        "\n    directory [; board options file [; default board]]"};
     ArgMatcher cachedirectory = {
         "cache-directory", "c", 1,
         "The directory for caching the core libraries."};
@@ -154,6 +265,65 @@ int main_application(int argc, const char *argv[]) {
         "default-board-options", "", 1,
         "The default board options to use when no board "
         "options file is specified"};
+    ArgMatcher exportCache = {
+        "export-cache", "", 1,
+        "Pack the core caches into the given archive after building."};
+    ArgMatcher importCache = {
+        "import-cache", "", 1,
+        "Unpack the core caches from the given archive before building."};
+    ArgMatcher ramDirectory = {
+        "ram-directory", "", 1,
+        "A RAM-backed directory (e.g. /dev/shm) for staging and building "
+        "the\n    examples. Falls back to the cache directory when the RAM "
+        "budget is exceeded."};
+    ArgMatcher ramBudget = {
+        "ram-budget", "", 1,
+        "The maximum size of the RAM directory in MiB (default: 1024)."};
+    ArgMatcher precompiledHeaders = {
+        "precompiled-headers", "", 0,
+        "Precompile the Arduino core headers once for every board."};
+    ArgMatcher sizeHistory = {
+        "size-history", "", 1,
+        "The file that keeps track of the firmware sizes of previous runs."};
+    ArgMatcher maxSizeRegression = {
+        "max-size-regression", "", 1,
+        "Fail if the flash or RAM usage of an example increases by more "
+        "than\n    the given number of bytes, or percentage (e.g. 2%)."};
+    ArgMatcher resume = {
+        "resume", "", 0,
+        "Continue an interrupted run: skip the examples that were already "
+        "built."};
+    ArgMatcher rerunFailed = {
+        "rerun-failed", "", 0,
+        "Only build the examples that failed in the previous run."};
+    ArgMatcher libraryIndex = {
+        "library-index", "", 0,
+        "Index the installed libraries once, and only pass the libraries "
+        "that\n    an example includes to arduino-builder."};
+    ArgMatcher pinCpus = {
+        "pin-cpus", "", 0,
+        "Give every parallel example its own set of CPU cores."};
+    ArgMatcher fastFeedback = {
+        "fast-feedback", "", 0,
+        "Start the examples that are most likely to fail first: the ones "
+        "that\n    failed last time, that changed since the last run, or "
+        "for boards that\n    often fail."};
+    ArgMatcher timeBudget = {
+        "time-budget", "", 1,
+        "Don't start any new examples after the given number of seconds, or "
+        "that\n    are expected to take longer than the remaining time (based "
+        "on the\n    previous run)."};
+    ArgMatcher remoteCache = {
+        "remote-cache", "", 1,
+        "The URL of a build cache server (e.g. http://localhost:8080) to "
+        "reuse\n    the results of identical builds from."};
+    ArgMatcher batchBoards = {
+        "batch-boards", "", 0,
+        "Build an example for all of its boards in one job, from a single "
+        "copy\n    of the example, instead of one job per board."};
+    ArgMatcher trace = {"trace", "", 1,
+                        "Write a Chrome trace event timeline of the run to "
+                        "the given JSON file."};
     ArgMatcher args = {
         "args", "a", 0,
         "The arguments to pass to arduino-builder.\n    This should be the "
@@ -206,59 +376,302 @@ int main_application(int argc, const char *argv[]) {
         std::cerr << "Error: --jobs expects an integer value" << std::endl;
         exit(1);
     }
-    options.directory = directory.getValueOrDefault(fs::current_path());
-    options.boardOptions = boardoptions.getValueOrDefault(
+    try {
+        options.ramBudget =
+            (ramBudget.matched ? std::stoull(ramBudget.arguments[0]) : 1024) *
+            1024 * 1024;
+    } catch (std::invalid_argument &e) {
+        std::cerr << "Error: --ram-budget expects an integer value"
+                  << std::endl;
+        exit(1);
+    }
+    try {
+        options.timeBudget =
+            timeBudget.matched ? std::stod(timeBudget.arguments[0]) : 0;
+    } catch (std::invalid_argument &e) {
+        std::cerr << "Error: --time-budget expects a number of seconds"
+                  << std::endl;
+        exit(1);
+    }
+    options.fastFeedback = fastFeedback.matched;
+    options.remoteCache = remoteCache.getValueOrDefault();
+    options.batchBoards = batchBoards.matched;
+    options.ramDirectory = ramDirectory.getValueOrDefault();
+    RootOptions defaultRoot;
+    defaultRoot.directory = fs::current_path();
+    defaultRoot.boardOptions = boardoptions.getValueOrDefault(
         fs::canonical("/proc/self/exe").parent_path() /
         "../share/arduino-example-builder/board-options.txt");
+    defaultRoot.defaultBoard =
+        defaultBoard.getValueOrDefault<std::string>("uno");
+    for (auto &dir : directory.arguments) {
+        options.roots.push_back(defaultRoot);
+        options.roots.back().directory = dir;
+    }
+    for (auto &file : roots.arguments) {
+        auto loaded = loadRoots(file, defaultRoot);
+        options.roots.insert(options.roots.end(), loaded.begin(), loaded.end());
+    }
+    if (options.roots.empty())
+        options.roots.push_back(defaultRoot);
+    // Without a trailing slash, so the name of every root is its last
+    // component
+    for (RootOptions &root : options.roots) {
+        root.directory = root.directory.lexically_normal();
+        if (root.directory.filename().empty() &&
+            root.directory.has_relative_path())
+            root.directory = root.directory.parent_path();
+    }
     options.cacheDirectory = cachedirectory.getValueOrDefault(
         fs::path("/tmp/arduino-example-builder"));
-    options.defaultBoard = defaultBoard.getValueOrDefault<std::string>("uno");
     options.defaultBoardOptions =
         defaultBoardOptions.getValueOrDefault<std::string>(
             "uno=arduino:avr:uno");
     options.verbose = verbose.matched;
+    options.precompiledHeaders = precompiledHeaders.matched;
+    options.libraryIndex = libraryIndex.matched;
+    options.exportCache = exportCache.getValueOrDefault();
+    options.sizeHistory = sizeHistory.getValueOrDefault(
+        options.cacheDirectory / "firmware-sizes.txt");
+    options.maxSizeRegression = maxSizeRegression.getValueOrDefault();
+    try {
+        isSizeRegression(1, 1, options.maxSizeRegression);
+    } catch (std::logic_error &e) { // invalid_argument or out_of_range
+        std::cerr << "Error: --max-size-regression expects a number of bytes "
+                     "or a percentage"
+                  << std::endl;
+        exit(1);
+    }
+    options.importCache = importCache.getValueOrDefault();
+    options.resume = resume.matched;
+    options.rerunFailed = rerunFailed.matched;
+
+    if (trace.matched)
+        Trace::enable();
+    Trace::setThread(0, "Main");
 
     // Configure the build process
-    ArduinoBuildJob::configure(options);
+    {
+        TraceSpan span("configure", "main");
+        ArduinoBuildJob::configure(options);
+    }
+    if (!options.importCache.empty()) {
+        TraceSpan span("import cache", "main");
+        importCoreCache(options.importCache);
+    }
+
+    // Record the outcome of every job as soon as it finishes
+    Journal journal = options.cacheDirectory / "journal.txt";
+    if (options.resume || options.rerunFailed)
+        journal.load();
+    else
+        journal.clear();
+
+    // Statistics of previous runs, to predict which jobs will fail. The
+    // sketches are hashed once, by the job slot that built them, so the main
+    // thread doesn't keep free slots waiting.
+    fs::path statsFile = options.cacheDirectory / "job-stats.txt";
+    JobStats stats;
+    stats.load(statsFile);
+    std::mutex sketchHashMutex;
+    std::map<fs::path, std::string> sketchHashes;
+    auto getSketchHash = [&](const fs::path &sketch) {
+        {
+            std::lock_guard<std::mutex> lock(sketchHashMutex);
+            auto it = sketchHashes.find(sketch);
+            if (it != sketchHashes.end())
+                return it->second;
+        }
+        std::string hash = hashSketchFolder(sketch);
+        std::lock_guard<std::mutex> lock(sketchHashMutex);
+        return sketchHashes.emplace(sketch, hash).first->second;
+    };
 
     // Start a job server for building
-    JobServer<ArduinoBuildJob> js = options.parallel;
-
-    // Schedule all .ino examples in this directory
-    for (auto &p : fs::recursive_directory_iterator(
-             options.directory,
-             fs::directory_options::skip_permission_denied)) {
-        if (p.path().extension() == ".ino") {
-            auto boards = ArduinoBuildJob::getBoards(p.path());
-            if (boards.empty())
-                js.schedule(p.path(), options.defaultBoard);
-            for (auto &board : boards)
-                js.schedule(p.path(), board);
+    JobServer<ArduinoBatchJob> js = options.parallel;
+    if (pinCpus.matched) {
+        auto cpuSets = partitionCpus(options.parallel, options.jobs);
+        if (options.verbose)
+            for (const cpu_set_t &cpus : cpuSets)
+                std::cout << "CPU set: " << toString(cpus) << std::endl;
+        ArduinoBuildJob::builderCpuSets = cpuSets;
+        js.setCpuSets(std::move(cpuSets));
+    }
+    ArduinoBatchJob::finishedCallback = [&](const ArduinoBuildJob &job) {
+        journal.append(job.getJournalEntry());
+        if (!job.getSkipped())
+            getSketchHash(job.getSketch());
+    };
+
+    // Schedule all .ino examples in these directories, except the ones that
+    // don't have to be built again according to the journal: all completed
+    // jobs when resuming, the successful ones when rerunning failed jobs.
+    // With --batch-boards, the remaining boards of an example are one job.
+    std::vector<ArduinoBuildJob> restoredJobs;
+    auto schedule = [&](const fs::path &sketch,
+                        const std::vector<std::string> &boards, size_t root) {
+        std::vector<ArduinoBuildJob> batch;
+        for (const std::string &board : boards) {
+            auto entry = journal.find(sketch.string(), board);
+            bool done = entry && (options.resume || entry->status == 0 ||
+                                  entry->skipped);
+            if (done)
+                restoredJobs.emplace_back(*entry, root);
+            else if (options.batchBoards)
+                batch.emplace_back(sketch, board, root);
+            else
+                js.schedule(
+                    std::vector<ArduinoBuildJob>{{sketch, board, root}});
+        }
+        if (!batch.empty())
+            js.schedule(std::move(batch));
+    };
+    for (size_t root = 0; root < options.roots.size(); ++root) {
+        TraceSpan span("discovery", "main");
+        const RootOptions &rootOptions = options.roots[root];
+        for (auto &p : fs::recursive_directory_iterator(
+                 rootOptions.directory,
+                 fs::directory_options::skip_permission_denied)) {
+            if (p.path().extension() == ".ino") {
+                auto boards = ArduinoBuildJob::getBoards(p.path());
+                if (boards.empty())
+                    boards.push_back(rootOptions.defaultBoard);
+                schedule(p.path(), boards, root);
+            }
         }
     }
+    if (options.fastFeedback) {
+        TraceSpan span("ranking", "main");
+        std::map<JobStats::Key, double> likelihoods;
+        auto getLikelihood = [&](const ArduinoBuildJob &job) {
+            JobStats::Key key = {job.getSketch().string(), job.getBoard()};
+            auto it = likelihoods.find(key);
+            if (it == likelihoods.end()) {
+                double likelihood = stats.getFailureLikelihood(
+                    key, getSketchHash(job.getSketch()));
+                it = likelihoods.emplace(key, likelihood).first;
+            }
+            return it->second;
+        };
+        auto getBatchLikelihood = [&](const ArduinoBatchJob &batch) {
+            double likelihood = 0;
+            for (const ArduinoBuildJob &job : batch.getJobs())
+                likelihood = std::max(likelihood, getLikelihood(job));
+            return likelihood;
+        };
+        js.sort([&](const ArduinoBatchJob &a, const ArduinoBatchJob &b) {
+            return getBatchLikelihood(a) > getBatchLikelihood(b);
+        });
+    }
+    if (options.timeBudget > 0) {
+        js.setDeadline(starttime + std::chrono::milliseconds(static_cast<long>(
+                                       options.timeBudget * 1000)));
+        // At worst, the boards of a batch are built one after the other
+        js.setDurationEstimate([&](const ArduinoBatchJob &batch) {
+            double duration = 0;
+            for (const ArduinoBuildJob &job : batch.getJobs())
+                if (auto record = stats.get(
+                        {job.getSketch().string(), job.getBoard()}))
+                    duration += record->duration;
+            return duration;
+        });
+    }
+
+    if (!restoredJobs.empty())
+        Blue(std::cout) << "Restored " << restoredJobs.size()
+                        << " job(s) from the journal" << std::endl;
+
+    struct RootSummary {
+        size_t successful = 0, failed = 0, sizeRegressions = 0;
+    };
+    std::vector<RootSummary> rootSummaries(options.roots.size());
 
     size_t numberSuccessfulJobs = 0;
     std::vector<ArduinoBuildJob> failedJobs;
     std::vector<ArduinoBuildJob> successfulJobs;
     std::vector<ArduinoBuildJob> skippedJobs;
+    std::vector<SizeChange> sizes;
+    auto collect = [&](ArduinoBuildJob &&finishedJob) {
+        auto result = finishedJob.getResult();
+        bool skipped = finishedJob.getSkipped();
+        size_t root = finishedJob.getRoot();
+        if (skipped) {
+            skippedJobs.emplace_back(std::move(finishedJob));
+        } else if (result.status == 0) {
+            ++numberSuccessfulJobs;
+            ++rootSummaries[root].successful;
+            // Sketches are identified relative to their root directory, and
+            // by the name of that directory if there are multiple roots
+            fs::path rootdir = options.roots[root].directory;
+            fs::path sketch =
+                finishedJob.getSketch().lexically_relative(rootdir);
+            if (options.roots.size() > 1)
+                sketch = rootdir.filename() / sketch;
+            if (finishedJob.getSize().isKnown())
+                sizes.push_back({{sketch.string(), finishedJob.getBoard()},
+                                 {},
+                                 finishedJob.getSize(),
+                                 root});
+            if (printsuccessful.matched)
+                successfulJobs.emplace_back(std::move(finishedJob));
+        } else {
+            ++rootSummaries[root].failed;
+            failedJobs.emplace_back(std::move(finishedJob));
+        }
+    };
+    for (auto &job : restoredJobs)
+        collect(std::move(job));
     while (!js.isFinished()) {
-        if (auto finishedJob = js.run()) {
-            auto result = finishedJob->getResult();
-            bool skipped = finishedJob->getSkipped();
-            if (skipped) {
-                skippedJobs.emplace_back(std::move(*finishedJob));
-            } else if (result.status == 0) {
-                ++numberSuccessfulJobs;
-                if (printsuccessful.matched)
-                    successfulJobs.emplace_back(std::move(*finishedJob));
-            } else {
-                failedJobs.emplace_back(std::move(*finishedJob));
+        if (auto finishedBatch = js.run()) {
+            for (ArduinoBuildJob &finishedJob : finishedBatch->getJobs()) {
+                if (!finishedJob.getSkipped())
+                    stats.update({finishedJob.getSketch().string(),
+                                  finishedJob.getBoard()},
+                                 finishedJob.getResult().status,
+                                 finishedJob.getDuration(),
+                                 getSketchHash(finishedJob.getSketch()));
+                collect(std::move(finishedJob));
             }
         }
     }
+    stats.save(statsFile);
+    std::vector<ArduinoBuildJob> notStartedJobs;
+    for (const ArduinoBatchJob &batch : js.getNotStarted())
+        notStartedJobs.insert(notStartedJobs.end(), batch.getJobs().begin(),
+                              batch.getJobs().end());
     size_t totalJobs = failedJobs.size() + numberSuccessfulJobs;
 
-    if (totalJobs == 0) {
+    // Compare the firmware sizes to the previous run. Regressions are not
+    // saved, so they keep failing until they're fixed.
+    SizeHistory history;
+    history.load(options.sizeHistory);
+    std::vector<SizeChange> sizeChanges;
+    size_t sizeRegressions = 0;
+    for (auto &c : sizes) {
+        auto before = history.get(c.key);
+        if (before) {
+            c.before = *before;
+            c.regression = isSizeRegression(c.before.flash, c.flashDelta(),
+                                            options.maxSizeRegression) ||
+                           isSizeRegression(c.before.ram, c.ramDelta(),
+                                            options.maxSizeRegression);
+            sizeRegressions += c.regression;
+            rootSummaries[c.root].sizeRegressions += c.regression;
+            sizeChanges.push_back(c);
+        }
+        if (!before || !c.regression)
+            history.set(c.key, c.after);
+    }
+    history.save(options.sizeHistory);
+
+    if (!options.exportCache.empty()) {
+        TraceSpan span("export cache", "main");
+        exportCoreCache(options.exportCache);
+    }
+    if (trace.matched)
+        Trace::write(trace.arguments[0]);
+
+    if (totalJobs == 0 && notStartedJobs.empty()) {
         Red(std::cerr) << "Error: no examples were found" << std::endl;
         exit(42);
     }
@@ -273,7 +686,22 @@ int main_application(int argc, const char *argv[]) {
         printSkippedJobs(skippedJobs);
     }
 
-    if (failedJobs.size() == 0) {
+    if (!notStartedJobs.empty()) {
+        YellowB(std::cout) << "\n"
+                           << "The following examples were not built within "
+                              "the time budget: \n";
+        printSkippedJobs(notStartedJobs);
+    }
+
+    printSizeIncreases(sizeChanges);
+
+    for (auto &c : sizeChanges)
+        if (c.regression)
+            RedB(std::cout) << "\n"
+                            << "Firmware size regression: " << c.key.first
+                            << " for board " << c.key.second << std::endl;
+
+    if (failedJobs.size() == 0 && sizeRegressions == 0) {
         GreenB(std::cout)
             << "\n"
             << " ╔═══════════════════════════════════════════════╗\n"
@@ -281,7 +709,8 @@ int main_application(int argc, const char *argv[]) {
             << numberSuccessfulJobs << " examples built successfully!  ✔    ║\n"
             << " ╚═══════════════════════════════════════════════╝\n"
             << std::endl;
-    } else {
+    }
+    if (failedJobs.size() > 0) {
         printJobs(failedJobs);
         RedB(std::cout)
             << "\n"
@@ -292,15 +721,41 @@ int main_application(int argc, const char *argv[]) {
             << " ╚═══════════════════════════════════════════════╝\n"
             << std::endl;
     }
+    if (sizeRegressions > 0) {
+        RedB(std::cout)
+            << "\n"
+            << " ╔═══════════════════════════════════════════════╗\n"
+            << " ║     " << std::setfill(' ') << std::setw(3)
+            << sizeRegressions << " of " << std::setw(3) << totalJobs
+            << " examples grew too large.       ║\n"
+            << " ╚═══════════════════════════════════════════════╝\n"
+            << std::endl;
+    }
+
+    if (options.roots.size() > 1) {
+        for (size_t root = 0; root < options.roots.size(); ++root) {
+            auto &summary = rootSummaries[root];
+            size_t exitcode = summary.failed + summary.sizeRegressions;
+            Color(std::cout, exitcode == 0 ? ANSIColors::greenb
+                                           : ANSIColors::redb)
+                << options.roots[root].directory << ": " << summary.failed
+                << " of " << (summary.failed + summary.successful)
+                << " examples failed to build, " << summary.sizeRegressions
+                << " grew too large (exit code " << exitcode << ")"
+                << std::endl;
+        }
+        std::cout << std::endl;
+    }
 
     auto endtime = std::chrono::steady_clock::now();
     std::chrono::duration<double> diff = endtime - starttime;
     std::cout << "Total time: " << std::setprecision(3) << diff.count()
               << " s\n";
-    std::cout << "Average time per example: " << std::setprecision(3)
-              << (diff.count() / totalJobs) << " s\n";
+    if (totalJobs > 0)
+        std::cout << "Average time per example: " << std::setprecision(3)
+                  << (diff.count() / totalJobs) << " s\n";
 
-    return failedJobs.size();
+    return failedJobs.size() + sizeRegressions;
 }
 
 int main(int argc, const char *argv[]) {
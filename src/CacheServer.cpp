@@ -0,0 +1,167 @@
+/// Minimal HTTP build cache server for `arduino-example-builder
+/// --remote-cache`, so results can be shared between runners on one machine
+/// or a LAN without any outside services.
+///
+/// Supports GET, HEAD and PUT on `/ac/<key>` and `/cas/<hash>`, where keys and
+/// hashes are lowercase hexadecimal MD5 digests. Entries are stored as files
+/// in the cache directory. Uploads to `/cas/` must match their hash.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <StringHelpers.hpp>
+
+namespace fs = std::filesystem;
+
+static fs::path cacheDirectory;
+
+static bool sendAll(int fd, const std::string &data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, 0);
+        if (n <= 0)
+            return false;
+        sent += n;
+    }
+    return true;
+}
+
+static void respond(int fd, int status, const std::string &reason,
+                    const std::string &body = "", bool head = false) {
+    std::ostringstream response;
+    response << "HTTP/1.1 " << status << ' ' << reason << "\r\n"
+             << "Content-Length: " << body.size() << "\r\n"
+             << "Connection: close\r\n\r\n";
+    if (!head)
+        response << body;
+    sendAll(fd, response.str());
+}
+
+static void handle(int fd) {
+    // Read the request line and the headers
+    std::string request;
+    char buffer[64 * 1024];
+    size_t headerEnd;
+    while ((headerEnd = request.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0 || request.size() > 64 * 1024)
+            return;
+        request.append(buffer, n);
+    }
+    std::istringstream headers(request.substr(0, headerEnd));
+    std::string method, path, line;
+    headers >> method >> path;
+    std::getline(headers, line);
+    size_t contentLength = 0;
+    bool expectContinue = false;
+    while (std::getline(headers, line)) {
+        size_t colon = line.find(':');
+        if (colon == std::string::npos)
+            continue;
+        std::string name = tolower_copy(line.substr(0, colon));
+        std::string value = line.substr(colon + 1);
+        if (name == "content-length")
+            contentLength = std::stoull(trim(value));
+        else if (name == "expect")
+            expectContinue = tolower_copy(trim(value)) == "100-continue";
+    }
+
+    std::smatch match;
+    if (!std::regex_match(path, match,
+                          std::regex("^/(ac|cas)/([0-9a-f]{32,64})$")))
+        return respond(fd, 404, "Not Found");
+    fs::path file = cacheDirectory / match[1].str() / match[2].str();
+
+    if (method == "GET" || method == "HEAD") {
+        std::ifstream in(file, std::ios::binary);
+        if (!in)
+            return respond(fd, 404, "Not Found", "", method == "HEAD");
+        std::ostringstream body;
+        body << in.rdbuf();
+        return respond(fd, 200, "OK", body.str(), method == "HEAD");
+    } else if (method == "PUT") {
+        if (expectContinue)
+            sendAll(fd, "HTTP/1.1 100 Continue\r\n\r\n");
+        std::string body = request.substr(headerEnd + 4);
+        while (body.size() < contentLength) {
+            ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+            if (n <= 0)
+                return;
+            body.append(buffer, n);
+        }
+        body.resize(contentLength);
+        if (match[1] == "cas" && md5(body) != match[2].str())
+            return respond(fd, 400, "Bad Request", "Hash mismatch\n");
+        // Write to a temporary file first, so readers never see partial
+        // entries
+        fs::path tmp = file;
+        tmp += ".tmp" + std::to_string(fd);
+        std::ofstream(tmp, std::ios::binary) << body;
+        fs::rename(tmp, file);
+        return respond(fd, 200, "OK");
+    }
+    respond(fd, 405, "Method Not Allowed");
+}
+
+int main(int argc, const char *argv[]) {
+    int port = 8080;
+    cacheDirectory = "/tmp/arduino-cache-server";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "--port" || arg == "-p") && i + 1 < argc) {
+            port = std::stoi(argv[++i]);
+        } else if ((arg == "--directory" || arg == "-d") && i + 1 < argc) {
+            cacheDirectory = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--port <port>] [--directory <cache directory>]"
+                      << std::endl;
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+    fs::create_directories(cacheDirectory / "ac");
+    fs::create_directories(cacheDirectory / "cas");
+
+    int server = socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (server < 0 ||
+        bind(server, reinterpret_cast<sockaddr *>(&address),
+             sizeof(address)) != 0 ||
+        listen(server, 64) != 0) {
+        std::cerr << "Error: couldn't listen on port " << port << ": "
+                  << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    std::cout << "Serving " << cacheDirectory << " on port " << port
+              << std::endl;
+
+    while (true) {
+        int client = accept(server, nullptr, nullptr);
+        if (client < 0)
+            continue;
+        std::thread([client] {
+            try {
+                handle(client);
+            } catch (std::exception &e) {
+                std::cerr << e.what() << std::endl;
+            }
+            close(client);
+        }).detach();
+    }
+}
@@ -0,0 +1,115 @@
+#include <ArduinoBuildJob.hpp>
+#include <CoreCache.hpp>
+#include <Printing.hpp>
+#include <StringHelpers.hpp>
+#include <fmt/format.h>
+#include <fstream>
+#include <vector>
+#include <sstream>
+
+/// Name of the file in the archive that lists its entries, one per line:
+/// `key <tab> fqbn <tab> core version`
+static constexpr const char *manifestName = "manifest.txt";
+
+void exportCoreCache(const fs::path &archive) {
+    using namespace fmt::literals;
+    const fs::path &cachedir = ArduinoBuildJob::cachedir;
+    fs::path staging = cachedir / ".cache-export";
+    fs::remove_all(staging);
+    fs::create_directories(staging);
+
+    // Sorted by FQBN, so the manifest is deterministic
+    std::vector<std::string> entries;
+    for (const std::string &fqbn : ArduinoBuildJob::fqbns) {
+        fs::path folder = ArduinoBuildJob::getCoreCacheFolder(fqbn);
+        std::error_code ec;
+        if (!fs::is_directory(folder, ec) || fs::is_empty(folder, ec))
+            continue;
+        std::string key = ArduinoBuildJob::getCacheKey(fqbn);
+        fs::copy(folder, staging / key, fs::copy_options::recursive);
+        entries.push_back(fmt::format("{}\t{}\t{}\n", key, fqbn,
+                                      ArduinoBuildJob::getCoreVersion(fqbn)));
+    }
+
+    std::ofstream manifest = staging / manifestName;
+    for (auto &entry : entries)
+        manifest << entry;
+    manifest.close();
+
+    // Fixed ordering, timestamps and ownership make the archive reproducible
+    fs::path absArchive = fs::absolute(archive);
+    if (absArchive.has_parent_path())
+        fs::create_directories(absArchive.parent_path());
+    std::string cmd = fmt::format(
+        "tar --sort=name --mtime=@0 --owner=0 --group=0 --numeric-owner "
+        "-C \"{staging}\" -cf - . | gzip -n -9 > \"{archive}\" 2>&1",
+        "staging"_a = staging.string(), "archive"_a = absArchive.string());
+    if (ArduinoBuildJob::verbose)
+        LockedOStream(std::cout, cout_mutex) << cmd << std::endl;
+    ExecResult result = exec(cmd);
+    fs::remove_all(staging);
+    if (result.status != 0)
+        throw std::runtime_error("Error: couldn't create core cache archive " +
+                                 archive.string() + "\n" + result.output);
+
+    Blue(std::cout) << "Exported " << entries.size() << " core cache(s) to "
+                    << archive << std::endl;
+}
+
+void importCoreCache(const fs::path &archive) {
+    using namespace fmt::literals;
+    if (!fs::exists(archive)) {
+        Yellow(std::cerr) << "Warning: core cache archive doesn't exist ("
+                          << archive << ")" << std::endl;
+        return;
+    }
+    const fs::path &cachedir = ArduinoBuildJob::cachedir;
+    fs::path staging = cachedir / ".cache-import";
+    fs::remove_all(staging);
+    fs::create_directories(staging);
+
+    // Extract with the current time as modification time, the builder
+    // considers a cached core stale if it's older than the core sources
+    std::string cmd = fmt::format(
+        "tar -xzmf \"{archive}\" -C \"{staging}\" 2>&1",
+        "staging"_a = staging.string(),
+        "archive"_a = fs::absolute(archive).string());
+    if (ArduinoBuildJob::verbose)
+        LockedOStream(std::cout, cout_mutex) << cmd << std::endl;
+    ExecResult result = exec(cmd);
+    if (result.status != 0) {
+        fs::remove_all(staging);
+        throw std::runtime_error("Error: couldn't extract core cache archive " +
+                                 archive.string() + "\n" + result.output);
+    }
+
+    std::ifstream manifest = staging / manifestName;
+    std::string line;
+    size_t imported = 0;
+    while (std::getline(manifest, line)) {
+        std::istringstream ss(line);
+        std::string key, fqbn, version;
+        std::getline(ss, key, '\t');
+        std::getline(ss, fqbn, '\t');
+        std::getline(ss, version, '\t');
+        if (key.empty() || fqbn.empty())
+            continue;
+        if (ArduinoBuildJob::fqbns.count(fqbn) == 0)
+            continue;
+        if (ArduinoBuildJob::getCacheKey(fqbn) != key) {
+            Yellow(std::cout) << "Rejected stale core cache for " << fqbn
+                              << " (" << version << ")" << std::endl;
+            continue;
+        }
+        fs::path folder = ArduinoBuildJob::getCoreCacheFolder(fqbn);
+        fs::create_directories(folder);
+        fs::copy(staging / key, folder,
+                 fs::copy_options::recursive |
+                     fs::copy_options::overwrite_existing);
+        ++imported;
+    }
+    fs::remove_all(staging);
+
+    Blue(std::cout) << "Imported " << imported << " core cache(s) from "
+                    << archive << std::endl;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+/// Pack the per-FQBN core caches in the cache directory into a compressed
+/// archive, keyed by FQBN, core version and builder command line.
+void exportCoreCache(const fs::path &archive);
+
+/// Unpack the core caches from an archive created by exportCoreCache into the
+/// cache directory, rejecting entries that don't match the current
+/// configuration.
+void importCoreCache(const fs::path &archive);
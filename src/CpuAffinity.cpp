@@ -0,0 +1,129 @@
+#include <CpuAffinity.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+static int readTopologyValue(int cpu, const char *name) {
+    std::ifstream file = fs::path("/sys/devices/system/cpu") /
+                         ("cpu" + std::to_string(cpu)) / "topology" / name;
+    int value = -1;
+    file >> value;
+    return value;
+}
+
+/// The NUMA node is a `nodeN` link in the CPU's sysfs directory
+static int getNumaNode(int cpu) {
+    std::error_code ec;
+    fs::path dir =
+        fs::path("/sys/devices/system/cpu") / ("cpu" + std::to_string(cpu));
+    for (auto &p : fs::directory_iterator(dir, ec)) {
+        std::string name = p.path().filename().string();
+        if (name.compare(0, 4, "node") == 0) {
+            try {
+                return std::stoi(name.substr(4));
+            } catch (std::invalid_argument &) {
+            }
+        }
+    }
+    return 0;
+}
+
+std::vector<cpu_set_t> partitionCpus(unsigned int slots,
+                                     unsigned int cpusPerSlot) {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        throw std::runtime_error("Error: sched_getaffinity() failed");
+
+    // Group the SMT siblings of each physical core, per NUMA node
+    using CoreId = std::pair<int, int>; // package, core
+    std::map<int, std::map<CoreId, std::vector<int>>> nodes;
+    size_t numberCores = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &allowed))
+            continue;
+        int package = readTopologyValue(cpu, "physical_package_id");
+        int core = readTopologyValue(cpu, "core_id");
+        // Without topology information, treat every CPU as a separate core
+        if (core < 0)
+            core = cpu;
+        auto &siblings = nodes[getNumaNode(cpu)][{package, core}];
+        numberCores += siblings.empty();
+        siblings.push_back(cpu);
+    }
+    if (nodes.empty() || slots == 0)
+        return {};
+
+    // Divide the slots over the nodes in proportion to their number of
+    // cores, the remaining slots go to the nodes with the largest remainders
+    std::vector<std::vector<const std::vector<int> *>> nodeCores;
+    std::vector<size_t> nodeSlots;
+    std::vector<std::pair<size_t, size_t>> remainders; // remainder, node
+    size_t assigned = 0;
+    for (auto &node : nodes) {
+        nodeCores.emplace_back();
+        for (auto &core : node.second)
+            nodeCores.back().push_back(&core.second);
+        size_t share = slots * nodeCores.back().size();
+        nodeSlots.push_back(share / numberCores);
+        assigned += nodeSlots.back();
+        remainders.push_back({share % numberCores, nodeCores.size() - 1});
+    }
+    std::stable_sort(remainders.begin(), remainders.end(),
+                     [](auto &a, auto &b) { return a.first > b.first; });
+    for (size_t i = 0; assigned < slots; ++i, ++assigned)
+        ++nodeSlots[remainders[i % remainders.size()].second];
+
+    // Every slot gets consecutive cores of a single node, until it has enough
+    // CPUs or its share of the node's cores. If a node has more slots than
+    // cores, its slots share the cores round-robin.
+    size_t wantedCpus = std::max(cpusPerSlot, 1u);
+    std::vector<cpu_set_t> sets;
+    sets.reserve(slots);
+    for (size_t node = 0; node < nodeCores.size(); ++node) {
+        if (nodeSlots[node] == 0)
+            continue;
+        const auto &cores = nodeCores[node];
+        size_t maxCores = std::max<size_t>(1, cores.size() / nodeSlots[node]);
+        size_t next = 0;
+        for (size_t slot = 0; slot < nodeSlots[node]; ++slot) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            size_t cpus = 0;
+            for (size_t i = 0; i < maxCores && cpus < wantedCpus; ++i) {
+                for (int cpu : *cores[next % cores.size()])
+                    CPU_SET(cpu, &set);
+                cpus += cores[next % cores.size()]->size();
+                ++next;
+            }
+            sets.push_back(set);
+        }
+    }
+    return sets;
+}
+
+cpu_set_t getCurrentThreadCpus() {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (sched_getaffinity(0, sizeof(cpus), &cpus) != 0)
+        throw std::runtime_error("Error: sched_getaffinity() failed");
+    return cpus;
+}
+
+void pinCurrentThread(const cpu_set_t &cpus) {
+    // Not fatal: the job still runs, just without a fixed CPU set
+    sched_setaffinity(0, sizeof(cpus), &cpus);
+}
+
+std::string toString(const cpu_set_t &cpus) {
+    std::string s;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &cpus))
+            s += (s.empty() ? "" : ",") + std::to_string(cpu);
+    return s;
+}
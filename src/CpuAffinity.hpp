@@ -0,0 +1,24 @@
+#pragma once
+
+#include <sched.h>
+#include <string>
+#include <vector>
+
+/// Divide the CPUs this process is allowed to run on into one CPU set per
+/// job slot. Every slot gets whole physical cores (all of their SMT
+/// siblings), enough for the given number of parallel compilations per slot.
+/// The slots are divided over the NUMA nodes in proportion to their number
+/// of cores, and every slot stays on a single node.
+/// If a node has more slots than cores, its slots share cores round-robin.
+std::vector<cpu_set_t> partitionCpus(unsigned int slots,
+                                     unsigned int cpusPerSlot);
+
+/// Get the CPUs the calling thread is allowed to run on
+cpu_set_t getCurrentThreadCpus();
+
+/// Restrict the calling thread (and the processes it spawns) to the given
+/// CPUs.
+void pinCurrentThread(const cpu_set_t &cpus);
+
+/// Format a CPU set as a list of CPU numbers, e.g. "0,1,8,9"
+std::string toString(const cpu_set_t &cpus);
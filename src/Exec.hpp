@@ -3,7 +3,7 @@
 #include <string>
 
 struct ExecResult {
-    int status;
+    int status = 0;
     std::string output;
 };
 
@@ -0,0 +1,59 @@
+#include <FirmwareSize.hpp>
+#include <fstream>
+#include <regex>
+#include <sstream>
+
+FirmwareSize parseFirmwareSize(const std::string &output) {
+    FirmwareSize size;
+    std::smatch match;
+    std::regex flash("Sketch uses ([0-9]+) bytes");
+    std::regex ram("Global variables use ([0-9]+) bytes");
+    if (std::regex_search(output, match, flash))
+        size.flash = std::stoll(match[1]);
+    if (std::regex_search(output, match, ram))
+        size.ram = std::stoll(match[1]);
+    return size;
+}
+
+/// The history file has one line per sketch and board:
+/// `sketch <tab> board <tab> flash <tab> ram`
+void SizeHistory::load(const fs::path &file) {
+    std::ifstream in = file;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream ss(line);
+        std::string sketch, board, flash, ram;
+        if (!std::getline(ss, sketch, '\t') || !std::getline(ss, board, '\t') ||
+            !std::getline(ss, flash, '\t') || !std::getline(ss, ram, '\t'))
+            continue;
+        try {
+            sizes[{sketch, board}] = {std::stoll(flash), std::stoll(ram)};
+        } catch (std::invalid_argument &) {
+            continue;
+        }
+    }
+}
+
+void SizeHistory::save(const fs::path &file) const {
+    // Write to a temporary file first, so an interrupted run doesn't
+    // corrupt the history
+    fs::path tmp = file;
+    tmp += ".tmp";
+    {
+        std::ofstream out = tmp;
+        if (!out)
+            throw std::runtime_error("Error: couldn't write size history " +
+                                     file.string());
+        for (auto &entry : sizes)
+            out << entry.first.first << '\t' << entry.first.second << '\t'
+                << entry.second.flash << '\t' << entry.second.ram << '\n';
+    }
+    fs::rename(tmp, file);
+}
+
+std::optional<FirmwareSize> SizeHistory::get(const Key &key) const {
+    auto it = sizes.find(key);
+    if (it == sizes.end())
+        return std::nullopt;
+    return it->second;
+}
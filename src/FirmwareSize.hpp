@@ -0,0 +1,34 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace fs = std::filesystem;
+
+struct FirmwareSize {
+    long long flash = -1; ///< Program storage space in bytes, -1 if unknown
+    long long ram = -1;   ///< Static RAM usage in bytes, -1 if unknown
+
+    bool isKnown() const { return flash >= 0 || ram >= 0; }
+};
+
+/// Extract the program and data size from the size report in the output of
+/// `arduino-builder`.
+FirmwareSize parseFirmwareSize(const std::string &output);
+
+/// The firmware sizes of previous runs, for each sketch and board.
+class SizeHistory {
+  public:
+    using Key = std::pair<std::string, std::string>; ///< Sketch and board
+
+    void load(const fs::path &file);
+    void save(const fs::path &file) const;
+
+    std::optional<FirmwareSize> get(const Key &key) const;
+    void set(const Key &key, FirmwareSize size) { sizes[key] = size; }
+
+  private:
+    std::map<Key, FirmwareSize> sizes;
+};
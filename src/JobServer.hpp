@@ -1,19 +1,26 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
+#include <functional>
 #include <future>
 #include <iostream>
 #include <memory>
 #include <optional>
 #include <vector>
 
+#include <CpuAffinity.hpp>
 #include <Printing.hpp>
+#include <Trace.hpp>
 
 template <class Job>
 class JobServer {
   public:
-    JobServer(unsigned int threads = 1) : futures(threads) { jobs.reserve(10); }
+    JobServer(unsigned int threads = 1)
+        : futures(threads), slotFreed(threads) {
+        jobs.reserve(10);
+    }
 
     template <class... Args>
     void schedule(Args &&... args) {
@@ -25,7 +32,56 @@ class JobServer {
         this->jobs.emplace_back(std::forward<Args>(args)...);
     }
 
-    void start() { started = true; }
+    /// Change the order in which the scheduled jobs will be started
+    template <class Compare>
+    void sort(Compare compare) {
+        if (started)
+            throw std::logic_error("Error: cannot reorder jobs, job server "
+                                   "is already started.");
+        std::stable_sort(jobs.begin(), jobs.end(), compare);
+    }
+
+    /// Don't start any new jobs after the given time, the jobs that are
+    /// running by then are allowed to finish
+    void setDeadline(std::chrono::steady_clock::time_point deadline) {
+        this->deadline = deadline;
+    }
+
+    /// Estimate how long a job will take, in seconds, to skip the jobs that
+    /// wouldn't finish before the deadline. Zero if unknown.
+    void setDurationEstimate(std::function<double(const Job &)> estimate) {
+        durationEstimate = std::move(estimate);
+    }
+
+    /// Get the jobs that were never started because the deadline passed, or
+    /// because they were not expected to finish before it
+    std::vector<Job> getNotStarted() const {
+        std::vector<Job> notStarted;
+        for (size_t i : skipped)
+            notStarted.push_back(jobs[i]);
+        notStarted.insert(notStarted.end(), jobs.begin() + nextToLaunch,
+                          jobs.end());
+        return notStarted;
+    }
+
+    /// Set a function to be called by the worker thread as soon as a job
+    /// finishes, before its result is collected by run().
+    void setFinishedCallback(std::function<void(const Job &)> callback) {
+        finishedCallback = std::move(callback);
+    }
+
+    /// Pin the jobs of each slot (and the processes they spawn) to the given
+    /// CPU set, one set per slot.
+    void setCpuSets(std::vector<cpu_set_t> sets) {
+        if (!sets.empty() && sets.size() != futures.size())
+            throw std::logic_error("Error: expected one CPU set per job slot");
+        cpuSets = std::move(sets);
+    }
+
+    void start() {
+        started = true;
+        std::fill(slotFreed.begin(), slotFreed.end(), Trace::clock::now());
+    }
 
     std::optional<Job> run() {
         using namespace std::chrono_literals;
@@ -37,18 +93,42 @@ class JobServer {
             start();
 
         Job *finishedJob = nullptr;
-        if (nextToLaunch < jobs.size()) { // There are still scheduled jobs
-                                          // waiting to be started
-            for (auto &fut : futures) {
+        bool pastDeadline =
+            deadline && std::chrono::steady_clock::now() > *deadline;
+        if (nextToLaunch < jobs.size() &&
+            !pastDeadline) { // There are still scheduled jobs
+                             // waiting to be started
+            for (size_t slot = 0; slot < futures.size(); ++slot) {
+                auto &fut = futures[slot];
                 if (fut.valid() == false || // uninitialized
                     fut.wait_for(10ms) == std::future_status::ready) {
                     // Get the result of the finished future
-                    finishedJob = fut.valid() ? fut.get() : nullptr;
+                    finishedJob = fut.valid() ? collect(slot) : nullptr;
+
+                    // Skip the jobs that won't finish before the deadline
+                    while (nextToLaunch < jobs.size() &&
+                           !fitsBeforeDeadline(jobs[nextToLaunch]))
+                        skipped.push_back(nextToLaunch++);
+                    if (nextToLaunch == jobs.size())
+                        break; // for
 
                     // Prepare the new task
                     Job *job = &jobs[nextToLaunch++];
-                    auto launch = [job]() -> Job * {
+                    auto freed = &slotFreed[slot];
+                    auto callback = &finishedCallback;
+                    auto cpus = cpuSets.empty() ? nullptr : &cpuSets[slot];
+                    auto launch = [job, slot, freed, callback,
+                                   cpus]() -> Job * {
+                        if (cpus)
+                            pinCurrentThread(*cpus);
+                        Trace::setThread(slot + 1,
+                                         "Job slot " + std::to_string(slot));
+                        Trace::record("queue wait", "scheduling", *freed,
+                                      Trace::clock::now());
                         job->run();
+                        if (*callback)
+                            (*callback)(*job);
+                        *freed = Trace::clock::now();
                         return job;
                     };
 
@@ -66,11 +146,12 @@ class JobServer {
         } else { // All scheduled jobs have been started
                  // (or have already finished)
             finished = true;
-            for (auto &fut : futures) {
+            for (size_t slot = 0; slot < futures.size(); ++slot) {
+                auto &fut = futures[slot];
                 if (fut.valid() == false) {
                     // finished, or not launched
                 } else if (fut.wait_for(10ms) == std::future_status::ready) {
-                    finishedJob = fut.get();
+                    finishedJob = collect(slot);
                     finished = false;
                     break; // for
                 } else {
@@ -88,8 +169,31 @@ class JobServer {
     bool isFinished() const { return finished; }
     bool isStarted() const { return started; }
 
+  private:
+    bool fitsBeforeDeadline(const Job &job) const {
+        if (!deadline || !durationEstimate)
+            return true;
+        auto duration = std::chrono::duration<double>(durationEstimate(job));
+        return std::chrono::steady_clock::now() + duration <= *deadline;
+    }
+
+    /// Get the finished job of the given slot, recording the time between the
+    /// job finishing and its result being collected.
+    Job *collect(size_t slot) {
+        Job *job = futures[slot].get();
+        Trace::record("result collection", "scheduling", slotFreed[slot],
+                      Trace::clock::now(), slot + 1);
+        return job;
+    }
+
   private:
     std::vector<std::future<Job *>> futures;
+    std::vector<Trace::clock::time_point> slotFreed;
+    std::function<void(const Job &)> finishedCallback;
+    std::vector<cpu_set_t> cpuSets;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    std::function<double(const Job &)> durationEstimate;
+    std::vector<size_t> skipped;
     std::vector<Job> jobs;
     size_t nextToLaunch = 0;
     bool started = false;
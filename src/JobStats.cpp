@@ -0,0 +1,93 @@
+#include <JobStats.hpp>
+#include <StringHelpers.hpp>
+#include <fstream>
+#include <sstream>
+
+/// The stats file has one line per sketch and board:
+/// `sketch <tab> board <tab> runs <tab> failures <tab> last status <tab>
+/// duration <tab> sketch hash`
+void JobStats::load(const fs::path &file) {
+    std::ifstream in = file;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream ss(line);
+        std::string sketch, board, runs, failures, status, duration;
+        JobRecord record;
+        if (!std::getline(ss, sketch, '\t') || !std::getline(ss, board, '\t') ||
+            !std::getline(ss, runs, '\t') ||
+            !std::getline(ss, failures, '\t') ||
+            !std::getline(ss, status, '\t') ||
+            !std::getline(ss, duration, '\t') ||
+            !std::getline(ss, record.sketchHash, '\t'))
+            continue;
+        try {
+            record.runs = std::stoul(runs);
+            record.failures = std::stoul(failures);
+            record.lastStatus = std::stoi(status);
+            record.duration = std::stod(duration);
+        } catch (std::invalid_argument &) {
+            continue;
+        }
+        records[{sketch, board}] = record;
+    }
+}
+
+void JobStats::save(const fs::path &file) const {
+    fs::path tmp = file;
+    tmp += ".tmp";
+    {
+        std::ofstream out = tmp;
+        if (!out)
+            throw std::runtime_error("Error: couldn't write job statistics " +
+                                     file.string());
+        for (auto &entry : records)
+            out << entry.first.first << '\t' << entry.first.second << '\t'
+                << entry.second.runs << '\t' << entry.second.failures << '\t'
+                << entry.second.lastStatus << '\t' << entry.second.duration
+                << '\t' << entry.second.sketchHash << '\n';
+    }
+    fs::rename(tmp, file);
+}
+
+std::optional<JobRecord> JobStats::get(const Key &key) const {
+    auto it = records.find(key);
+    if (it == records.end())
+        return std::nullopt;
+    return it->second;
+}
+
+void JobStats::update(const Key &key, int status, double duration,
+                      const std::string &sketchHash) {
+    JobRecord &record = records[key];
+    ++record.runs;
+    record.failures += status != 0;
+    record.lastStatus = status;
+    record.duration = duration;
+    record.sketchHash = sketchHash;
+}
+
+double JobStats::getFailureRate(const std::string &board) const {
+    unsigned int runs = 0, failures = 0;
+    for (auto &entry : records) {
+        if (entry.first.second == board) {
+            runs += entry.second.runs;
+            failures += entry.second.failures;
+        }
+    }
+    return runs == 0 ? 0 : double(failures) / runs;
+}
+
+double JobStats::getFailureLikelihood(const Key &key,
+                                      const std::string &sketchHash) const {
+    auto record = get(key);
+    double likelihood = getFailureRate(key.second);
+    if (!record || record->sketchHash != sketchHash)
+        likelihood += 2;
+    if (record && record->lastStatus != 0)
+        likelihood += 4;
+    return likelihood;
+}
+
+std::string hashSketchFolder(const fs::path &sketch) {
+    return hashFolder(sketch.parent_path());
+}
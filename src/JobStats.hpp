@@ -0,0 +1,45 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace fs = std::filesystem;
+
+struct JobRecord {
+    unsigned int runs = 0;
+    unsigned int failures = 0;
+    int lastStatus = 0;
+    double duration = 0;    ///< Duration of the last run in seconds
+    std::string sketchHash; ///< Hash of the sketch folder of the last run
+};
+
+/// Statistics of previous runs of each job, used to predict which jobs are
+/// most likely to fail.
+class JobStats {
+  public:
+    using Key = std::pair<std::string, std::string>; ///< Sketch and board
+
+    void load(const fs::path &file);
+    void save(const fs::path &file) const;
+
+    std::optional<JobRecord> get(const Key &key) const;
+    void update(const Key &key, int status, double duration,
+                const std::string &sketchHash);
+
+    /// The fraction of all previous runs for the given board that failed
+    double getFailureRate(const std::string &board) const;
+
+    /// Jobs that failed last time come first, then jobs of which the sketch
+    /// changed since the last run (or that never ran), then jobs for boards
+    /// that often fail. Higher is more likely to fail.
+    double getFailureLikelihood(const Key &key,
+                                const std::string &sketchHash) const;
+
+  private:
+    std::map<Key, JobRecord> records;
+};
+
+/// Hash the contents of all files in the folder of the given sketch
+std::string hashSketchFolder(const fs::path &sketch);
@@ -0,0 +1,98 @@
+#include <Journal.hpp>
+#include <sstream>
+
+/// Escape tabs, newlines and backslashes, so the output fits on one line
+static std::string escape(const std::string &s) {
+    std::string escaped;
+    for (char c : s) {
+        switch (c) {
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default: escaped += c;
+        }
+    }
+    return escaped;
+}
+
+static std::string unescape(const std::string &s) {
+    std::string unescaped;
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] == '\\' && i + 1 < s.size()) {
+            switch (s[++i]) {
+                case 'n': unescaped += '\n'; break;
+                case 'r': unescaped += '\r'; break;
+                case 't': unescaped += '\t'; break;
+                default: unescaped += s[i];
+            }
+        } else {
+            unescaped += s[i];
+        }
+    }
+    return unescaped;
+}
+
+/// Every line is `status <tab> skipped <tab> board <tab> sketch <tab> output
+/// <tab> $`, the final `$` marks a complete entry.
+void Journal::load() {
+    std::ifstream in = file;
+    std::string line;
+    // End of the last complete line, anything after it is a truncated entry
+    std::streamoff complete = 0;
+    while (std::getline(in, line)) {
+        if (line.size() < 2 || line.compare(line.size() - 2, 2, "\t$") != 0 ||
+            in.eof())
+            continue;
+        complete = in.tellg();
+        std::istringstream ss(line);
+        JournalEntry entry;
+        std::string status, skipped, output;
+        if (!std::getline(ss, status, '\t') ||
+            !std::getline(ss, skipped, '\t') ||
+            !std::getline(ss, entry.board, '\t') ||
+            !std::getline(ss, entry.sketch, '\t') ||
+            !std::getline(ss, output, '\t'))
+            continue;
+        try {
+            entry.status = std::stoi(status);
+        } catch (std::invalid_argument &) {
+            continue;
+        }
+        entry.skipped = skipped == "1";
+        entry.output = unescape(output);
+        entries[{entry.sketch, entry.board}] = std::move(entry);
+    }
+    in.close();
+
+    // Remove the truncated entry, so the next one starts on a new line
+    std::error_code ec;
+    if (fs::exists(file, ec) &&
+        fs::file_size(file, ec) != static_cast<uintmax_t>(complete))
+        fs::resize_file(file, complete);
+    out.open(file, std::ios::app);
+}
+
+void Journal::clear() {
+    entries.clear();
+    out.open(file, std::ios::trunc);
+}
+
+void Journal::append(const JournalEntry &entry) {
+    std::ostringstream line;
+    line << entry.status << '\t' << entry.skipped << '\t' << entry.board
+         << '\t' << entry.sketch << '\t' << escape(entry.output) << "\t$\n";
+    std::lock_guard<std::mutex> lock(mutex);
+    out << line.str() << std::flush;
+    if (!out)
+        throw std::runtime_error("Error: couldn't write to journal " +
+                                 file.string());
+}
+
+std::optional<JournalEntry> Journal::find(const std::string &sketch,
+                                          const std::string &board) const {
+    auto it = entries.find({sketch, board});
+    if (it == entries.end())
+        return std::nullopt;
+    return it->second;
+}
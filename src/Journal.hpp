@@ -0,0 +1,44 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace fs = std::filesystem;
+
+struct JournalEntry {
+    std::string sketch;
+    std::string board;
+    int status = 0;
+    bool skipped = false;
+    std::string output;
+};
+
+/// Append-only record of the jobs that completed, so an interrupted or
+/// partially failed run can be resumed.
+/// Every entry is written as a single line and flushed as soon as the job
+/// finishes, a truncated last line (after a crash) is removed when loading.
+class Journal {
+  public:
+    Journal(fs::path file) : file(std::move(file)) {}
+
+    /// Load the entries of the previous run(s), and keep appending to them
+    void load();
+    /// Start a new journal, discarding the previous entries
+    void clear();
+    /// Add the outcome of a job (thread-safe)
+    void append(const JournalEntry &entry);
+
+    /// The latest outcome of the given job, if it's in the journal
+    std::optional<JournalEntry> find(const std::string &sketch,
+                                     const std::string &board) const;
+
+  private:
+    fs::path file;
+    std::ofstream out;
+    std::mutex mutex;
+    std::map<std::pair<std::string, std::string>, JournalEntry> entries;
+};
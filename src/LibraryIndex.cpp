@@ -0,0 +1,129 @@
+#include <LibraryIndex.hpp>
+#include <fstream>
+#include <regex>
+
+static bool isSourceFile(const fs::path &path) {
+    static const std::set<std::string> extensions = {
+        ".ino", ".pde", ".c", ".cpp", ".cc", ".h", ".hpp", ".hh", ".tpp", ".S",
+    };
+    return extensions.count(path.extension().string()) > 0;
+}
+
+/// Add the headers included by the given file
+static void scanIncludes(const fs::path &path,
+                         std::set<std::string> &includes) {
+    static const std::regex re(
+        "^\\s*#\\s*include\\s*[<\"]([^>\"]+)[>\"].*");
+    std::ifstream file = path;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.find("include") == std::string::npos)
+            continue;
+        std::smatch match;
+        if (std::regex_match(line, match, re) && match.size() == 2)
+            includes.insert(match[1]);
+    }
+}
+
+/// Get the headers included by all source files in the given folder, and in
+/// its subfolders if `recursive` is set
+static std::set<std::string> scanIncludes(const fs::path &folder,
+                                          bool recursive = true) {
+    std::set<std::string> includes;
+    std::error_code ec;
+    auto options = fs::directory_options::skip_permission_denied;
+    if (recursive) {
+        for (auto &p : fs::recursive_directory_iterator(folder, options, ec))
+            if (p.is_regular_file(ec) && isSourceFile(p.path()))
+                scanIncludes(p.path(), includes);
+    } else {
+        for (auto &p : fs::directory_iterator(folder, options, ec))
+            if (p.is_regular_file(ec) && isSourceFile(p.path()))
+                scanIncludes(p.path(), includes);
+    }
+    return includes;
+}
+
+/// Libraries in the 1.5 format have their sources in `src`, older libraries
+/// have them in the library root
+static fs::path getSourceFolder(const fs::path &library) {
+    fs::path src = library / "src";
+    if (fs::exists(library / "library.properties") && fs::is_directory(src))
+        return src;
+    return library;
+}
+
+/// Get the headers included by the sources that the builder compiles: all of
+/// `src` for libraries in the 1.5 format, only the root and the `utility`
+/// folder for older libraries (not their `examples` or `extras`)
+static std::set<std::string> scanLibraryIncludes(const fs::path &library) {
+    fs::path src = getSourceFolder(library);
+    if (src != library)
+        return scanIncludes(src);
+    auto includes = scanIncludes(library, false);
+    includes.merge(scanIncludes(library / "utility", false));
+    return includes;
+}
+
+void LibraryIndex::build(const std::vector<fs::path> &folders) {
+    std::error_code ec;
+    for (const fs::path &folder : folders) {
+        for (auto &library : fs::directory_iterator(folder, ec)) {
+            if (!library.is_directory(ec))
+                continue;
+            ++libraries;
+            fs::path src = getSourceFolder(library.path());
+            for (auto &header : fs::directory_iterator(src, ec)) {
+                auto ext = header.path().extension();
+                if (ext == ".h" || ext == ".hpp" || ext == ".hh")
+                    headers.emplace(header.path().filename().string(),
+                                    library.path());
+            }
+        }
+    }
+}
+
+const std::set<std::string> &
+LibraryIndex::getIncludes(const fs::path &library) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = includes.find(library);
+        if (it != includes.end())
+            return it->second;
+    }
+    // Scan outside of the lock, another thread may do the same work, but
+    // elements of a map are never invalidated by insertion
+    auto scanned = scanLibraryIncludes(library);
+    std::lock_guard<std::mutex> lock(mutex);
+    return includes.emplace(library, std::move(scanned)).first->second;
+}
+
+std::set<fs::path> LibraryIndex::resolve(const fs::path &sketchfolder) {
+    std::set<fs::path> libraries;
+    std::vector<std::string> todo;
+    for (auto &include : scanIncludes(sketchfolder))
+        todo.push_back(include);
+    while (!todo.empty()) {
+        std::string include = std::move(todo.back());
+        todo.pop_back();
+        // Headers that aren't in the index are provided by the core or the
+        // toolchain
+        auto header = headers.find(fs::path(include).filename().string());
+        if (header == headers.end() ||
+            !libraries.insert(header->second).second)
+            continue;
+        for (auto &libinclude : getIncludes(header->second))
+            todo.push_back(libinclude);
+    }
+    return libraries;
+}
+
+void LibraryIndex::createView(const fs::path &view,
+                              const std::set<fs::path> &libraries) {
+    fs::create_directories(view);
+    std::error_code ec;
+    // If two libraries have the same folder name, the first one is used
+    for (const fs::path &library : libraries)
+        fs::create_directory_symlink(fs::absolute(library),
+                                     view / library.filename(), ec);
+}
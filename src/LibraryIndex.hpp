@@ -0,0 +1,39 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+/// Maps header files to the Arduino libraries that provide them, so every
+/// sketch can be built with only the libraries it actually includes, instead
+/// of having the builder scan all installed libraries.
+class LibraryIndex {
+  public:
+    /// Index the libraries in the given folders. If multiple libraries provide
+    /// the same header, the one in the earliest folder is used.
+    void build(const std::vector<fs::path> &folders);
+
+    /// Get the libraries in the include closure of the sources in the given
+    /// folder.
+    std::set<fs::path> resolve(const fs::path &sketchfolder);
+
+    /// Create a libraries folder with links to the given libraries only.
+    static void createView(const fs::path &view,
+                           const std::set<fs::path> &libraries);
+
+    size_t size() const { return libraries; }
+
+  private:
+    /// The headers included by the sources of a library (cached)
+    const std::set<std::string> &getIncludes(const fs::path &library);
+
+    std::map<std::string, fs::path> headers;
+    std::map<fs::path, std::set<std::string>> includes;
+    std::mutex mutex;
+    size_t libraries = 0;
+};
@@ -0,0 +1,172 @@
+#include <ArduinoBuildJob.hpp>
+#include <PrecompiledHeader.hpp>
+#include <Printing.hpp>
+#include <StringHelpers.hpp>
+#include <Trace.hpp>
+#include <fmt/format.h>
+#include <fstream>
+#include <future>
+#include <map>
+#include <regex>
+#include <sstream>
+
+using Properties = std::map<std::string, std::string>;
+
+/// Escape a string so it can be used between double quotes in a shell command
+static std::string shellEscape(const std::string &s) {
+    std::string escaped;
+    for (char c : s) {
+        if (c == '"' || c == '\\' || c == '$' || c == '`')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+/// Ask the builder for the build properties of the given FQBN
+static Properties dumpBuildProperties(const std::string &fqbn,
+                                      const fs::path &pchfolder) {
+    using namespace fmt::literals;
+    fs::path sketchfolder = pchfolder / "pch";
+    fs::create_directories(sketchfolder);
+    std::ofstream(sketchfolder / "pch.ino") << "void setup() {}\n"
+                                               "void loop() {}\n";
+    std::string cmd = //
+        fmt::format("cd \"{folder}\" && "
+                    "{command} "
+                    "-fqbn {fqbn} "
+                    "-build-path \"{buildpath}\" "
+                    "-dump-prefs \"{file}\" 2>&1",
+                    "folder"_a = ArduinoBuildJob::arduinoFolder.string(),
+                    "command"_a = ArduinoBuildJob::command, //
+                    "fqbn"_a = fqbn,                        //
+                    "buildpath"_a = pchfolder.string(),     //
+                    "file"_a = (sketchfolder / "pch.ino").string());
+    if (ArduinoBuildJob::verbose)
+        LockedOStream(std::cout, cout_mutex) << cmd << std::endl;
+    ExecResult result = exec(cmd);
+    if (result.status != 0)
+        throw std::runtime_error("Error: couldn't dump build properties for " +
+                                 fqbn + "\n" + result.output);
+
+    Properties properties;
+    std::istringstream ss(result.output);
+    std::string line;
+    while (std::getline(ss, line)) {
+        auto eq = line.find('=');
+        if (eq != std::string::npos)
+            properties[line.substr(0, eq)] = rtrim(line).substr(eq + 1);
+    }
+    return properties;
+}
+
+/// Recursively replace all {key} placeholders by their property values
+static std::string expand(std::string value, const Properties &properties) {
+    std::regex re("\\{([^{}]+)\\}");
+    for (int depth = 0; depth < 16; ++depth) {
+        std::string expanded;
+        auto begin = std::sregex_iterator(value.begin(), value.end(), re);
+        auto last = value.cbegin();
+        for (auto it = begin; it != std::sregex_iterator(); ++it) {
+            auto property = properties.find((*it)[1]);
+            expanded.append(last, value.cbegin() + it->position());
+            expanded += property == properties.end() ? it->str()
+                                                     : property->second;
+            last = value.cbegin() + it->position() + it->length();
+        }
+        expanded.append(last, value.cend());
+        if (expanded == value)
+            break;
+        value = std::move(expanded);
+    }
+    return value;
+}
+
+/// Run the C++ compile recipe of the board on the given source file
+static ExecResult runRecipe(Properties properties, const fs::path &source,
+                            const fs::path &object, const std::string &extra) {
+    std::string includes = fmt::format(
+        "\"-I{}\" \"-I{}\" {}", properties["build.core.path"],
+        properties["build.variant.path"], extra);
+    properties["includes"] = includes;
+    properties["source_file"] = source.string();
+    properties["object_file"] = object.string();
+    std::string cmd =
+        expand(properties["recipe.cpp.o.pattern"], properties) + " 2>&1";
+    if (ArduinoBuildJob::verbose)
+        LockedOStream(std::cout, cout_mutex) << cmd << std::endl;
+    return exec(cmd);
+}
+
+static std::string buildPrecompiledHeader(const std::string &fqbn) {
+    fs::path pchfolder = ArduinoBuildJob::cachedir / "pch" / md5(fqbn);
+    fs::remove_all(pchfolder);
+    fs::create_directories(pchfolder);
+
+    Properties properties = dumpBuildProperties(fqbn, pchfolder);
+    if (properties.count("recipe.cpp.o.pattern") == 0)
+        throw std::runtime_error("Error: no C++ recipe for " + fqbn);
+
+    // Precompile the core header. The language has to be specified before
+    // the source file, the include paths are the last flags before it.
+    fs::path header = pchfolder / "ArduinoPCH.h";
+    std::ofstream(header) << "#include <Arduino.h>\n";
+    ExecResult result = runRecipe(properties, header,
+                                  header.string() + ".gch", "-x c++-header");
+    if (result.status != 0)
+        throw std::runtime_error("Error: couldn't precompile " +
+                                 header.string() + "\n" + result.output);
+
+    // Make sure that the compiler accepts the precompiled header with the
+    // flags that are used for the sketch sources
+    std::string useflags =
+        fmt::format("-include \"{}\" -Winvalid-pch", header.string());
+    fs::path test = pchfolder / "pch-test.cpp";
+    std::ofstream(test) << "void pchTest() {}\n";
+    result = runRecipe(properties, test, pchfolder / "pch-test.o",
+                       useflags + " -Werror=invalid-pch");
+    if (result.status != 0)
+        throw std::runtime_error("Error: precompiled header flags don't "
+                                 "match for " + fqbn + "\n" + result.output);
+
+    // The sketch flags are appended to the board's own extra flags
+    std::string extraflags = properties["compiler.cpp.extra_flags"];
+    return fmt::format("-prefs \"compiler.cpp.extra_flags={}\" ",
+                       shellEscape(trim_copy(extraflags + " " + useflags)));
+}
+
+static std::mutex pchMutex;
+static std::map<std::string, std::shared_future<std::string>> pchArgs;
+
+std::string getPrecompiledHeaderArgs(const std::string &fqbn) {
+    std::promise<std::string> promise;
+    std::shared_future<std::string> args;
+    bool owner = false;
+    {
+        std::lock_guard<std::mutex> lock(pchMutex);
+        auto it = pchArgs.find(fqbn);
+        if (it == pchArgs.end()) {
+            args = pchArgs[fqbn] = promise.get_future().share();
+            owner = true;
+        } else {
+            args = it->second;
+        }
+    }
+    if (owner) {
+        TraceSpan span("precompile headers " + fqbn, "job");
+        try {
+            promise.set_value(buildPrecompiledHeader(fqbn));
+            LockedBlue(std::cout, cout_mutex)
+                << "Precompiled core headers for " << fqbn << std::endl;
+        } catch (std::exception &e) {
+            // Fall back to compiling without precompiled header
+            LockedYellow(std::cout, cout_mutex)
+                << "Warning: not using precompiled headers for " << fqbn
+                << std::endl;
+            if (ArduinoBuildJob::verbose)
+                LockedOStream(std::cout, cout_mutex) << e.what() << std::endl;
+            promise.set_value("");
+        }
+    }
+    return args.get();
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+/// Get the extra `arduino-builder` arguments that make the C++ sources of a
+/// sketch use a precompiled version of the Arduino core headers for the given
+/// fully qualified board name.
+/// The header is precompiled by the first caller for each FQBN, concurrent
+/// callers wait for it. Returns an empty string if the header couldn't be
+/// precompiled or if the compiler refuses to use it with the sketch flags.
+std::string getPrecompiledHeaderArgs(const std::string &fqbn);
@@ -0,0 +1,90 @@
+#include <Printing.hpp>
+#include <RemoteCache.hpp>
+#include <StringHelpers.hpp>
+#include <fmt/format.h>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+bool RemoteCache::get(const std::string &path, const fs::path &file) const {
+    return exec(fmt::format("curl -sf -o \"{}\" \"{}{}\" 2>&1", file.string(),
+                            url, path))
+               .status == 0;
+}
+
+bool RemoteCache::put(const std::string &path, const fs::path &file) const {
+    return exec(fmt::format("curl -sf -T \"{}\" \"{}{}\" 2>&1", file.string(),
+                            url, path))
+               .status == 0;
+}
+
+bool RemoteCache::exists(const std::string &path) const {
+    return exec(fmt::format("curl -sfI \"{}{}\" 2>&1", url, path)).status == 0;
+}
+
+static std::string readFile(const fs::path &file) {
+    std::ifstream in(file, std::ios::binary);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+/// A job result is stored as:
+///
+///     <status>
+///     artifact <hash> <filename>    (zero or more)
+///     output
+///     <output of the builder>
+std::optional<ExecResult> RemoteCache::lookup(const std::string &key,
+                                              const fs::path &tmpfolder) const {
+    fs::create_directories(tmpfolder);
+    fs::path file = tmpfolder / (key + ".ac");
+    bool found = get("/ac/" + key, file);
+    std::istringstream entry(found ? readFile(file) : "");
+    fs::remove(file);
+    if (!found)
+        return std::nullopt;
+
+    ExecResult result;
+    std::string line;
+    if (!(entry >> result.status) || !std::getline(entry, line))
+        return std::nullopt;
+    while (std::getline(entry, line) && line != "output") {
+        std::istringstream artifact(line);
+        std::string type, hash;
+        artifact >> type >> hash;
+        if (type != "artifact" || !exists("/cas/" + hash))
+            return std::nullopt;
+    }
+    std::ostringstream output;
+    output << entry.rdbuf();
+    result.output = output.str();
+    return result;
+}
+
+void RemoteCache::upload(const std::string &key, const ExecResult &result,
+                         const fs::path &buildfolder,
+                         const fs::path &tmpfolder) const {
+    std::ostringstream entry;
+    entry << result.status << '\n';
+    std::error_code ec;
+    for (auto &p : fs::directory_iterator(buildfolder, ec)) {
+        auto ext = p.path().extension();
+        if (ext != ".hex" && ext != ".bin" && ext != ".elf")
+            continue;
+        std::string hash = md5(readFile(p.path()));
+        if (!put("/cas/" + hash, p.path()))
+            return;
+        entry << "artifact " << hash << ' '
+              << p.path().filename().string() << '\n';
+    }
+    entry << "output\n" << result.output;
+
+    // The job result is uploaded last, so it never refers to missing
+    // artifacts
+    fs::create_directories(tmpfolder);
+    fs::path file = tmpfolder / (key + ".ac");
+    std::ofstream(file, std::ios::binary) << entry.str();
+    put("/ac/" + key, file);
+    fs::remove(file);
+}
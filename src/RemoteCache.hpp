@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Exec.hpp>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace fs = std::filesystem;
+
+/// Client for an HTTP build cache (see CacheServer.cpp), modeled after
+/// Bazel's HTTP cache protocol:
+///
+///   - `/ac/<key>`: the result of the job with the given key, the hash of
+///     all its inputs
+///   - `/cas/<hash>`: build artifacts, addressed by the hash of their
+///     contents
+///
+/// Both are read with GET and written with PUT, using `curl`.
+class RemoteCache {
+  public:
+    RemoteCache(std::string url = "") : url(std::move(url)) {
+        while (!this->url.empty() && this->url.back() == '/')
+            this->url.pop_back();
+    }
+
+    bool isEnabled() const { return !url.empty(); }
+
+    /// Get the result of a job that was built before. The entry only counts
+    /// if all of its artifacts are still available.
+    std::optional<ExecResult> lookup(const std::string &key,
+                                     const fs::path &tmpfolder) const;
+
+    /// Upload the result of a successful job and its build artifacts (the
+    /// .hex, .bin and .elf files in the build folder).
+    void upload(const std::string &key, const ExecResult &result,
+                const fs::path &buildfolder, const fs::path &tmpfolder) const;
+
+  private:
+    bool get(const std::string &path, const fs::path &file) const;
+    bool put(const std::string &path, const fs::path &file) const;
+    bool exists(const std::string &path) const;
+
+    std::string url;
+};
@@ -1,4 +1,6 @@
+#include <fstream>
 #include <openssl/md5.h>
+#include <set>
 #include <vector>
 
 #include <StringHelpers.hpp>
@@ -8,10 +10,7 @@ static inline char nibbletohex(uint8_t n) {
     return n + ((n < 10) ? '0' : 'a' - 10);
 }
 
-std::string md5(const std::string &s) {
-    std::vector<uint8_t> result;
-    result.resize(128 / 8);
-    MD5((const uint8_t *)s.data(), s.size(), result.data());
+static std::string tohex(const std::vector<uint8_t> &result) {
     std::string resultstr;
     resultstr.resize(2 * 128 / 8);
     for (size_t i = 0; i < result.size(); ++i) {
@@ -19,4 +18,38 @@ std::string md5(const std::string &s) {
         resultstr[2 * i + 1] = nibbletohex(result[i] >> 0);
     }
     return resultstr;
-}
\ No newline at end of file
+}
+
+std::string md5(const std::string &s) {
+    std::vector<uint8_t> result;
+    result.resize(128 / 8);
+    MD5((const uint8_t *)s.data(), s.size(), result.data());
+    return tohex(result);
+}
+
+std::string hashFolder(const std::filesystem::path &folder) {
+    namespace fs = std::filesystem;
+    // Sorted, so the hash doesn't depend on the directory order
+    std::set<fs::path> files;
+    std::error_code ec;
+    for (auto &p : fs::recursive_directory_iterator(
+             folder, fs::directory_options::follow_directory_symlink, ec))
+        if (p.is_regular_file(ec))
+            files.insert(p.path());
+    // Hashed one chunk at a time, the folder can be hundreds of megabytes
+    MD5_CTX context;
+    MD5_Init(&context);
+    std::vector<char> buffer(64 * 1024);
+    for (auto &file : files) {
+        std::string name = file.lexically_relative(folder).string();
+        MD5_Update(&context, name.c_str(), name.size() + 1);
+        std::ifstream in(file, std::ios::binary);
+        while (in.read(buffer.data(), buffer.size()) || in.gcount() > 0)
+            MD5_Update(&context, buffer.data(), in.gcount());
+        MD5_Update(&context, "", 1);
+    }
+    std::vector<uint8_t> result;
+    result.resize(128 / 8);
+    MD5_Final(result.data(), &context);
+    return tohex(result);
+}
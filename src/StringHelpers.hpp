@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <filesystem>
 #include <locale>
 
 // trim from start (in place)
@@ -57,4 +58,8 @@ static inline std::string tolower_copy(std::string s) {
     return s;
 }
 
-std::string md5(const std::string &s);
\ No newline at end of file
+std::string md5(const std::string &s);
+
+/// Hash the names (relative to the folder) and contents of all files in the
+/// given folder, following symlinks to other folders
+std::string hashFolder(const std::filesystem::path &folder);
@@ -0,0 +1,81 @@
+#include <Trace.hpp>
+#include <fmt/format.h>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <vector>
+
+bool Trace::enabled = false;
+
+static std::mutex traceMutex;
+static std::vector<std::string> traceEvents;
+static std::set<unsigned int> traceThreadsNamed;
+static thread_local unsigned int traceThread = 0;
+static const Trace::clock::time_point traceEpoch = Trace::clock::now();
+
+static std::string jsonEscape(const std::string &s) {
+    std::string escaped;
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        if (static_cast<unsigned char>(c) < 0x20)
+            escaped += fmt::format("\\u{:04x}", c);
+        else
+            escaped += c;
+    }
+    return escaped;
+}
+
+static long long toMicroseconds(Trace::clock::time_point t) {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(t - traceEpoch).count();
+}
+
+void Trace::setThread(unsigned int tid, const std::string &name) {
+    traceThread = tid;
+    if (!enabled)
+        return;
+    std::string event = fmt::format(
+        R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},)"
+        R"("args":{{"name":"{}"}}}})",
+        tid, jsonEscape(name));
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (traceThreadsNamed.insert(tid).second)
+        traceEvents.push_back(std::move(event));
+}
+
+unsigned int Trace::getThread() { return traceThread; }
+
+void Trace::setThread(unsigned int tid) { traceThread = tid; }
+
+void Trace::record(const std::string &name, const std::string &category,
+                   clock::time_point start, clock::time_point end,
+                   unsigned int tid, const std::string &args) {
+    if (!enabled)
+        return;
+    std::string event = fmt::format(
+        R"({{"name":"{}","cat":"{}","ph":"X","ts":{},"dur":{},"pid":1,)"
+        R"("tid":{}{}}})",
+        jsonEscape(name), jsonEscape(category), toMicroseconds(start),
+        toMicroseconds(end) - toMicroseconds(start), tid,
+        args.empty() ? "" : ",\"args\":" + args);
+    std::lock_guard<std::mutex> lock(traceMutex);
+    traceEvents.push_back(std::move(event));
+}
+
+void Trace::record(const std::string &name, const std::string &category,
+                   clock::time_point start, clock::time_point end) {
+    record(name, category, start, end, traceThread);
+}
+
+void Trace::write(const fs::path &file) {
+    std::ofstream out = file;
+    if (!out)
+        throw std::runtime_error("Error: couldn't open trace file " +
+                                 file.string());
+    std::lock_guard<std::mutex> lock(traceMutex);
+    out << "{\"traceEvents\":[\n";
+    for (size_t i = 0; i < traceEvents.size(); ++i)
+        out << traceEvents[i] << (i + 1 < traceEvents.size() ? ",\n" : "\n");
+    out << "],\"displayTimeUnit\":\"ms\"}\n";
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+/// Collects Chrome trace events (viewable in chrome://tracing or Perfetto).
+/// Recording is a no-op unless the trace is enabled.
+class Trace {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    static void enable() { enabled = true; }
+    static bool isEnabled() { return enabled; }
+
+    /// Set the timeline the calling thread records its spans on, thread 0 is
+    /// the main thread, thread i > 0 is job slot i - 1, and thread 1000 i + j
+    /// is board j of a batch in job slot i - 1.
+    static void setThread(unsigned int tid, const std::string &name);
+    /// Record the calling thread's spans on an already named timeline
+    static void setThread(unsigned int tid);
+    /// Get the timeline the calling thread records its spans on
+    static unsigned int getThread();
+
+    /// Record a complete span on the given thread
+    static void record(const std::string &name, const std::string &category,
+                       clock::time_point start, clock::time_point end,
+                       unsigned int tid, const std::string &args = "");
+    /// Record a complete span on the calling thread's timeline
+    static void record(const std::string &name, const std::string &category,
+                       clock::time_point start, clock::time_point end);
+
+    /// Write all recorded events to a JSON file
+    static void write(const fs::path &file);
+
+  private:
+    static bool enabled;
+};
+
+/// Records a span from its construction until its destruction.
+class TraceSpan {
+  public:
+    TraceSpan(std::string name, std::string category)
+        : name(std::move(name)), category(std::move(category)),
+          start(Trace::clock::now()) {}
+    ~TraceSpan() { Trace::record(name, category, start, Trace::clock::now()); }
+
+  private:
+    std::string name;
+    std::string category;
+    Trace::clock::time_point start;
+};